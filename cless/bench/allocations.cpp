@@ -0,0 +1,34 @@
+#include "allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::size_t> count{0};
+}
+
+namespace cless::bench {
+
+std::size_t allocations() {
+    return count.load(std::memory_order_relaxed);
+}
+
+}  // namespace cless::bench
+
+// the array and nothrow forms call these, so every allocation of the program goes through them; aligned forms are
+// left to the library since nothing on the lexer path over-aligns
+void* operator new(std::size_t size) {
+    count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,14 @@
+#ifndef CLESS_BENCH_ALLOCATIONS_H
+#define CLESS_BENCH_ALLOCATIONS_H
+
+#include <cstddef>
+
+namespace cless::bench {
+
+// number of calls to the global operator new since the program started, over all threads; the benchmark binary
+// replaces operator new to count them
+std::size_t allocations();
+
+}  // namespace cless::bench
+
+#endif
@@ -0,0 +1,189 @@
+#include "corpus.h"
+
+#include <array>
+
+namespace cless::bench {
+
+namespace {
+
+// splitmix64
+class Random {
+    std::uint64_t state;
+
+public:
+    explicit Random(std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    std::size_t below(std::size_t n) {
+        return next() % n;
+    }
+
+    template <typename T, std::size_t N>
+    const T &pick(const std::array<T, N> &items) {
+        return items[below(N)];
+    }
+};
+
+constexpr std::array<std::string_view, 24> words = {
+    "buffer", "count",  "node",   "index",  "offset", "length", "state",   "entry",
+    "parent", "child",  "config", "handle", "result", "value",  "context", "stream",
+    "token",  "symbol", "table",  "cache",  "limit",  "flags",  "target",  "source",
+};
+
+constexpr std::array<std::string_view, 10> types = {
+    "int", "unsigned", "long", "char", "double", "size_t", "struct node *", "const char *", "uint64_t", "float",
+};
+
+void identifier(Random &random, std::string &text) {
+    text += random.pick(words);
+    text += '_';
+    text += random.pick(words);
+    if (random.below(2) == 0)
+        text += std::to_string(random.below(100));
+}
+
+// declarations and calls, long names and few operators
+void identifierLine(Random &random, std::string &text) {
+    text += "    ";
+    text += random.pick(types);
+    text += ' ';
+    identifier(random, text);
+    text += " = ";
+    identifier(random, text);
+    text += '(';
+    identifier(random, text);
+    text += ", ";
+    identifier(random, text);
+    text += "->";
+    identifier(random, text);
+    text += ");\n";
+}
+
+// license banners, doc comments and trailing comments around a little code
+void commentLine(Random &random, std::string &text) {
+    switch (random.below(4)) {
+        case 0:
+            text += "/*\n * Copyright (c) The Authors. All rights reserved.\n";
+            text += " * Permission is hereby granted, free of charge, to any person obtaining a copy\n */\n";
+            break;
+        case 1:
+            text += "/**\n * Returns the ";
+            text += random.pick(words);
+            text += " of the ";
+            text += random.pick(words);
+            text += ", or NULL when the table is empty.\n *\n * @param ";
+            text += random.pick(words);
+            text += " must not be NULL\n */\n";
+            break;
+        case 2:
+            text += "    // TODO: the ";
+            text += random.pick(words);
+            text += " is recomputed for every ";
+            text += random.pick(words);
+            text += "; cache it\n";
+            break;
+        default:
+            text += "    ";
+            identifier(random, text);
+            text += "++;  /* see above */  // keep in sync\n";
+            break;
+    }
+}
+
+// every form of constant and literal, with escapes
+void literalLine(Random &random, std::string &text) {
+    constexpr std::array<std::string_view, 8> integers = {
+        "0", "42", "0x7fffffff", "0755", "18446744073709551615ULL", "100000L", "0XDEADBEEFu", "1234567890",
+    };
+    constexpr std::array<std::string_view, 8> floatings = {
+        "1.0", "3.14159265358979", ".5f", "1e-10", "6.02214076e23L", "0.001", "2.", "1.5E+300",
+    };
+    constexpr std::array<std::string_view, 8> characters = {
+        "'a'", "'\\n'", "'\\''", "'\\0'", "'\\x41'", "'\\177'", "L'x'", "'\\\\'",
+    };
+    constexpr std::array<std::string_view, 6> strings = {
+        "\"hello, world\\n\"",
+        "\"%s:%d: error: %s\\n\"",
+        "\"tab\\tseparated\\tvalues\"",
+        "\"quote \\\" and backslash \\\\ inside\"",
+        "\"\\x1b[1;31mred\\x1b[0m\"",
+        "L\"wide string\"",
+    };
+    text += "    x = ";
+    text += random.pick(integers);
+    text += " + ";
+    text += random.pick(floatings);
+    text += "; c = ";
+    text += random.pick(characters);
+    text += "; s = ";
+    text += random.pick(strings);
+    text += ' ';
+    text += random.pick(strings);
+    text += ";\n";
+}
+
+// expressions with one-letter names, dense in operators and brackets
+void punctuationLine(Random &random, std::string &text) {
+    constexpr std::array<std::string_view, 24> operators = {
+        "+",  "-",  "*",  "/",  "%",  "<<", ">>", "&",  "|",  "^",   "&&",  "||",
+        "==", "!=", "<=", ">=", "<",  ">",  "+=", "-=", "<<=", ">>=", "|=", "&=",
+    };
+    constexpr std::array<std::string_view, 6> operands = {"a[i]", "p->q", "s.t", "(x)", "++b", "c--"};
+    text += "    ";
+    for (std::size_t i = 0, n = 3 + random.below(5); i < n; i++) {
+        if (random.below(4) == 0)
+            text += random.below(2) == 0 ? "~" : "!";
+        text += random.pick(operands);
+        text += ' ';
+        text += random.pick(operators);
+        text += ' ';
+    }
+    text += random.below(2) == 0 ? "f(a, b)[0] ? *p : &q->r;\n" : "(y) {};\n";
+}
+
+}  // namespace
+
+std::string_view name(Corpus corpus) {
+    switch (corpus) {
+        case Corpus::Identifiers:
+            return "identifiers";
+        case Corpus::Comments:
+            return "comments";
+        case Corpus::Literals:
+            return "literals";
+        case Corpus::Punctuation:
+            return "punctuation";
+    }
+    return "";
+}
+
+std::string generate(Corpus corpus, std::size_t size, std::uint64_t seed) {
+    Random random(seed);
+    std::string text;
+    text.reserve(size + 256);
+    while (text.size() < size) {
+        switch (corpus) {
+            case Corpus::Identifiers:
+                identifierLine(random, text);
+                break;
+            case Corpus::Comments:
+                commentLine(random, text);
+                break;
+            case Corpus::Literals:
+                literalLine(random, text);
+                break;
+            case Corpus::Punctuation:
+                punctuationLine(random, text);
+                break;
+        }
+    }
+    return text;
+}
+
+}  // namespace cless::bench
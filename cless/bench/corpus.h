@@ -0,0 +1,28 @@
+#ifndef CLESS_BENCH_CORPUS_H
+#define CLESS_BENCH_CORPUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cless::bench {
+
+// what most of the bytes of a generated file are spent on
+enum class Corpus {
+    Identifiers,
+    Comments,
+    Literals,
+    Punctuation,
+};
+
+std::string_view name(Corpus corpus);
+
+// Lexically valid C text of at least size bytes, ending with a newline. The text only depends on the arguments: the
+// generator uses its own PRNG rather than <random>, whose distributions differ between standard libraries, so runs on
+// different machines lex the same bytes.
+std::string generate(Corpus corpus, std::size_t size, std::uint64_t seed = 1);
+
+}  // namespace cless::bench
+
+#endif
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "allocations.h"
+#include "corpus.h"
+#include "cless/front-end/lexer/lexer.h"
+
+namespace {
+using cless::bench::Corpus;
+namespace source = cless::core::source;
+namespace types = cless::core::types;
+namespace lexer = cless::fend::lexer;
+
+// Lexes the file the way the driver does, with recovery on. A lexer owns its token buffer and arena and interns into
+// a fresh table, so every iteration pays for what one translation unit pays for. Besides time, reports the rate in
+// bytes and tokens and the operator new calls per token.
+void lexFile(benchmark::State& state, source::SourceManager& sources, source::FileID file) {
+    std::size_t tokens = 0;
+    auto start = cless::bench::allocations();
+    for (auto _ : state) {
+        types::DiagnosticsEngine diags(nullptr);
+        types::StringInterner interner;
+        lexer::Lexer lexer(sources, diags, interner, file);
+        lexer.setErrorRecovery(true);
+        auto batch = lexer.tokenizeAll();
+        tokens = batch.tokens.size();
+        benchmark::DoNotOptimize(batch);
+    }
+    auto allocations = cless::bench::allocations() - start;
+    state.SetBytesProcessed(state.iterations() * sources.buffer(file).size());
+    state.counters["tokens"] = benchmark::Counter(tokens * state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["allocs/token"] =
+        static_cast<double>(allocations) / static_cast<double>(std::max<std::size_t>(tokens * state.iterations(), 1));
+}
+
+std::uint64_t corpus_seed = 1;
+
+void BM_Lexer(benchmark::State& state, Corpus corpus) {
+    source::SourceManager sources;
+    auto file = sources.addBuffer(
+        std::string(cless::bench::name(corpus)) + ".c",
+        source::SourceBuffer::fromString(cless::bench::generate(corpus, state.range(0), corpus_seed)));
+    lexFile(state, sources, file.value());
+}
+
+void BM_LexerFile(benchmark::State& state, const std::string& path) {
+    source::SourceManager sources;
+    auto file = sources.loadFile(path);
+    if (not file.has_value()) {
+        state.SkipWithError(std::strerror(file.error()));
+        return;
+    }
+    lexFile(state, sources, file.value());
+}
+
+// the files under test-data, error cases included, each as one benchmark named after its path
+void registerTestData() {
+    std::filesystem::path root = CLESS_TEST_DATA_DIR;
+    std::vector<std::filesystem::path> paths;
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator(root, error);
+         it != std::filesystem::recursive_directory_iterator();
+         it.increment(error)) {
+        if (it->is_regular_file() and it->path().extension() == ".c")
+            paths.push_back(it->path());
+    }
+    std::sort(paths.begin(), paths.end());
+    for (const auto& path : paths) {
+        auto name = "BM_LexerFile/" + path.lexically_relative(root).generic_string();
+        benchmark::RegisterBenchmark(name.c_str(), BM_LexerFile, path.string());
+    }
+}
+
+// one benchmark per kind of corpus, at the sizes given or from 64 KiB to 16 MiB
+void registerCorpora(const std::vector<std::int64_t>& sizes) {
+    for (auto corpus : {Corpus::Identifiers, Corpus::Comments, Corpus::Literals, Corpus::Punctuation}) {
+        auto name = "BM_Lexer/" + std::string(cless::bench::name(corpus));
+        auto* bench = benchmark::RegisterBenchmark(name.c_str(), BM_Lexer, corpus);
+        if (sizes.empty())
+            bench->RangeMultiplier(4)->Range(1 << 16, 1 << 24);
+        for (auto size : sizes)
+            bench->Arg(size);
+    }
+}
+
+}  // namespace
+
+// Takes the flags of Google Benchmark, and --corpus_size=BYTES (repeatable) to lex generated files of other sizes and
+// --corpus_seed=N to lex other files of the same mix.
+int main(int argc, char* argv[]) {
+    benchmark::Initialize(&argc, argv);
+    std::vector<std::int64_t> sizes;
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--corpus_size="))
+            sizes.push_back(std::stoll(std::string(arg.substr(std::string_view("--corpus_size=").size()))));
+        else if (arg.starts_with("--corpus_seed="))
+            corpus_seed = std::stoull(std::string(arg.substr(std::string_view("--corpus_seed=").size())));
+        else
+            argv[kept++] = argv[i];
+    }
+    argc = kept;
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    registerCorpora(sizes);
+    registerTestData();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
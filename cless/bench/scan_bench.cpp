@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+#include <string.h>
+
+#include <cctype>
+#include <string>
+
+#include "cless/core/source/scan.h"
+#include "cless/core/source/source_buffer.h"
+
+namespace {
+using cless::core::source::SourceBuffer;
+namespace scan = cless::core::source::scan;
+
+// license banners and doc comments, as found at the top of vendored headers
+SourceBuffer commentHeavySource(std::size_t size) {
+    std::string text;
+    while (text.size() < size) {
+        text += "/*\n * Copyright (c) The Authors. All rights reserved.\n";
+        text += " * Permission is hereby granted, free of charge, to any person obtaining a copy\n */\n";
+        text += "    // Returns the number of elements currently stored in the container.\n";
+        text += "\t\t  \n\n";
+    }
+    text += "x";
+    return SourceBuffer::fromString(text);
+}
+
+// the per-character loop that skipWhitespacesAndComments() used before the kernels, including line bookkeeping
+const char* skipLegacy(const char* ptr, std::size_t& line, std::size_t& col) {
+    auto adv = [&]() {
+        if (*ptr == '\0')
+            return;
+        if (*ptr == '\n') {
+            line++;
+            col = 0;
+        }
+        ptr++;
+        col++;
+    };
+    while (true) {
+        if (std::isspace(*ptr)) {
+            adv();
+        } else if (*ptr == '/' and *(ptr + 1) == '/') {
+            adv(), adv();
+            while (*ptr != '\n' and *ptr != '\0')
+                adv();
+            adv();
+        } else if (*ptr == '/' and *(ptr + 1) == '*') {
+            adv(), adv();
+            while (*ptr != '\0' and (*ptr != '*' or *(ptr + 1) != '/'))
+                adv();
+            adv(), adv();
+        } else {
+            return ptr;
+        }
+    }
+}
+
+const char* skipWithKernels(const char* ptr, std::size_t& line, std::size_t& col) {
+    while (true) {
+        const char* p = scan::skipBlanks(ptr);
+        bool more = true;
+        if (*p == '/' and *(p + 1) == '/') {
+            p = scan::findLineEnd(p + 2);
+            if (*p == '\n')
+                p++;
+        } else if (*p == '/' and *(p + 1) == '*') {
+            p = scan::findCommentEnd(p + 2);
+            if (*p != '\0')
+                p += 2;
+        } else {
+            more = false;
+        }
+        if (auto newlines = scan::countNewlines(ptr, p); newlines > 0) {
+            line += newlines;
+            col = p - static_cast<const char*>(::memrchr(ptr, '\n', p - ptr));
+        } else {
+            col += p - ptr;
+        }
+        ptr = p;
+        if (not more)
+            return ptr;
+    }
+}
+
+void BM_SkipLegacy(benchmark::State& state) {
+    auto source = commentHeavySource(state.range(0));
+    for (auto _ : state) {
+        std::size_t line = 1, col = 1;
+        benchmark::DoNotOptimize(skipLegacy(source.data(), line, col));
+        benchmark::DoNotOptimize(line);
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+void BM_SkipKernel(benchmark::State& state, scan::Kernel kernel) {
+    if (not scan::isSupported(kernel)) {
+        state.SkipWithError("kernel not supported on this CPU");
+        return;
+    }
+    auto previous = scan::activeKernel();
+    scan::useKernel(kernel);
+    auto source = commentHeavySource(state.range(0));
+    for (auto _ : state) {
+        std::size_t line = 1, col = 1;
+        benchmark::DoNotOptimize(skipWithKernels(source.data(), line, col));
+        benchmark::DoNotOptimize(line);
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+    scan::useKernel(previous);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SkipLegacy)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_SkipKernel, scalar, scan::Kernel::Scalar)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_SkipKernel, sse2, scan::Kernel::Sse2)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_SkipKernel, avx2, scan::Kernel::Avx2)->Range(1 << 12, 1 << 22);
@@ -0,0 +1,68 @@
+#ifndef CLESS_CORE_INSTRUMENT_INSTRUMENT_H
+#define CLESS_CORE_INSTRUMENT_INSTRUMENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace cless::core::instrument {
+
+// Scoped timers and counters for finding where compile time goes. Recording is off until enable(); until then a timer
+// or a counter is one relaxed load and a branch, and no clock is read. Every thread records into its own log without
+// locking, and the logs are only read once the work is done, for a summary or a trace.
+//
+// A phase is named by a string literal, so a new stage only needs a Timer around its work to show up in both.
+
+namespace detail {
+extern std::atomic<bool> active;
+
+std::int64_t now();
+void record(const char *name, std::string_view context, std::int64_t start, std::int64_t end);
+void add(const char *name, std::uint64_t amount);
+}  // namespace detail
+
+inline bool enabled() {
+    return detail::active.load(std::memory_order_relaxed);
+}
+
+// starts recording; timestamps count from here
+void enable();
+
+// names the calling thread's track in the trace; ignored before enable()
+void setThreadName(std::string name);
+
+// Records the time from construction to destruction as one event on the calling thread. context, such as the path of
+// the file worked on, is shown with the event in the trace and must outlive the timer.
+class Timer {
+    const char *name;
+    std::string_view context;
+    std::int64_t start;
+
+public:
+    explicit Timer(const char *name, std::string_view context = {})
+        : name(name), context(context), start(enabled() ? detail::now() : -1) {}
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+    ~Timer() {
+        if (start >= 0)
+            detail::record(name, context, start, detail::now());
+    }
+};
+
+// adds amount to the counter name, summed over all threads in the report
+inline void count(const char *name, std::uint64_t amount = 1) {
+    if (enabled())
+        detail::add(name, amount);
+}
+
+// Summary in the style of -ftime-report: time and calls per phase, summed over threads so that parallel phases can
+// add up to more than the wall time, and the counters.
+void writeTimeReport(std::ostream &out);
+// Timeline in the Chrome trace event format, one track per thread; false if path cannot be written.
+bool writeTrace(const std::string &path);
+
+}  // namespace cless::core::instrument
+
+#endif
@@ -0,0 +1,179 @@
+#include "cless/core/instrument/instrument.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cless::core::instrument {
+
+namespace {
+
+struct Event {
+    const char* name;
+    std::string context;
+    std::int64_t start;
+    std::int64_t end;
+};
+
+struct ThreadLog {
+    std::size_t id;
+    std::string name;
+    std::vector<Event> events;
+    std::unordered_map<std::string_view, std::uint64_t> counters;
+};
+
+// Logs are owned here rather than by their threads, so events of a worker that has exited are still reported. The
+// mutex only guards the list; a log is written by its own thread alone.
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadLog>> logs;
+std::chrono::steady_clock::time_point epoch;
+
+ThreadLog& threadLog() {
+    thread_local ThreadLog* log = [] {
+        std::lock_guard lock(registry_mutex);
+        auto id = logs.size();
+        logs.push_back(std::make_unique<ThreadLog>(ThreadLog{id, "thread " + std::to_string(id), {}, {}}));
+        return logs.back().get();
+    }();
+    return *log;
+}
+
+void writeJsonString(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' or c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<int>(c));
+            out << escape;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+namespace detail {
+
+std::atomic<bool> active{false};
+
+std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void record(const char* name, std::string_view context, std::int64_t start, std::int64_t end) {
+    threadLog().events.push_back({name, std::string(context), start, end});
+}
+
+void add(const char* name, std::uint64_t amount) {
+    threadLog().counters[name] += amount;
+}
+
+}  // namespace detail
+
+void enable() {
+    epoch = std::chrono::steady_clock::now();
+    detail::active.store(true, std::memory_order_relaxed);
+}
+
+void setThreadName(std::string name) {
+    if (enabled())
+        threadLog().name = std::move(name);
+}
+
+void writeTimeReport(std::ostream& out) {
+    struct Phase {
+        std::int64_t time = 0;
+        std::size_t calls = 0;
+    };
+    std::map<std::string_view, Phase> phases;
+    std::map<std::string_view, std::uint64_t> counters;
+    {
+        std::lock_guard lock(registry_mutex);
+        for (const auto& log : logs) {
+            for (const auto& event : log->events) {
+                auto& phase = phases[event.name];
+                phase.time += event.end - event.start;
+                phase.calls++;
+            }
+            for (const auto& [name, amount] : log->counters)
+                counters[name] += amount;
+        }
+    }
+    std::vector<std::pair<std::string_view, Phase>> sorted(phases.begin(), phases.end());
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.time > b.second.time;
+    });
+
+    auto wall = detail::now();
+    auto flags = out.flags();
+    out << "===" << std::string(73, '-') << "===\n";
+    out << "                              cless time report\n";
+    out << "===" << std::string(73, '-') << "===\n";
+    out << std::fixed << std::setprecision(4);
+    out << "  Total wall time: " << wall * 1e-9 << " seconds\n\n";
+    out << "   Time (s)   (% wall)      Calls  Phase\n";
+    for (const auto& [name, phase] : sorted) {
+        out << std::setw(11) << phase.time * 1e-9 << "  (" << std::setprecision(1) << std::setw(6)
+            << (wall > 0 ? 100.0 * phase.time / wall : 0.0) << "%)" << std::setprecision(4) << std::setw(11)
+            << phase.calls << "  " << name << '\n';
+    }
+    if (not counters.empty()) {
+        out << "\n      Count  Counter\n";
+        for (const auto& [name, amount] : counters)
+            out << std::setw(11) << amount << "  " << name << '\n';
+    }
+    out.flags(flags);
+}
+
+bool writeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (not out)
+        return false;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+    std::lock_guard lock(registry_mutex);
+    for (const auto& log : logs) {
+        separate();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << log->id << ",\"args\":{\"name\":";
+        writeJsonString(out, log->name);
+        out << "}}";
+        separate();
+        out << "{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << log->id
+            << ",\"args\":{\"sort_index\":" << log->id << "}}";
+        // complete events in microseconds
+        for (const auto& event : log->events) {
+            separate();
+            out << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"cat\":\"cless\",\"ph\":\"X\",\"pid\":1,\"tid\":" << log->id << ",\"ts\":" << event.start * 1e-3
+                << ",\"dur\":" << (event.end - event.start) * 1e-3;
+            if (not event.context.empty()) {
+                out << ",\"args\":{\"context\":";
+                writeJsonString(out, event.context);
+                out << '}';
+            }
+            out << '}';
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+}  // namespace cless::core::instrument
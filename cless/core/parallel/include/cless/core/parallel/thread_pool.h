@@ -0,0 +1,56 @@
+#ifndef CLESS_CORE_PARALLEL_THREAD_POOL_H
+#define CLESS_CORE_PARALLEL_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cless::core::parallel {
+
+// Fixed set of worker threads shared by every stage that splits its work. Work stealing: a worker queues the tasks it
+// posts on its own deque and runs them newest first, while idle workers take the oldest tasks of busy ones. A thread
+// that waits for parallel work runs the work itself, so a task may use the pool it runs on without deadlocking.
+class ThreadPool {
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // one queue per worker, then one for tasks posted from outside the pool
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::atomic<std::size_t> pending;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping;
+    std::vector<std::thread> workers;
+
+public:
+    // Parallel work runs on threads threads, like make -j: the thread that waits for it is one of them, so threads - 1
+    // workers are started and a pool of 1 runs everything on the caller. 0 uses one thread per hardware thread.
+    explicit ThreadPool(std::size_t threads = 0);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    // the number of threads that run parallel work, the caller included
+    std::size_t size() const;
+
+    // calls body(i) for every i in [0, count) and returns once all calls are done; indices are handed out in
+    // increasing order to the calling thread and to idle workers
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body);
+
+private:
+    void post(std::function<void()> task);
+    bool take(std::size_t self, std::function<void()> &task);
+    void run(std::size_t self);
+};
+
+}  // namespace cless::core::parallel
+
+#endif
@@ -0,0 +1,123 @@
+#include "cless/core/parallel/thread_pool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "cless/core/instrument/instrument.h"
+
+namespace cless::core::parallel {
+
+// the pool and queue index of the worker running on this thread
+static thread_local const ThreadPool* current_pool = nullptr;
+static thread_local std::size_t current_queue = 0;
+
+ThreadPool::ThreadPool(std::size_t threads) : pending(0), stopping(false) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    // the caller of parallelFor is the last of the threads
+    for (std::size_t i = 0; i < threads; i++)
+        queues.push_back(std::make_unique<Queue>());
+    workers.reserve(threads - 1);
+    for (std::size_t i = 0; i + 1 < threads; i++)
+        workers.emplace_back([this, i] {
+            instrument::setThreadName("worker " + std::to_string(i));
+            run(i);
+        });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+std::size_t ThreadPool::size() const {
+    return workers.size() + 1;
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    // helpers may only get to run after the loop is over, so they share the counters instead of borrowing them
+    struct Loop {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto loop = std::make_shared<Loop>();
+    auto work = [loop, count, &body] {
+        std::size_t i;
+        while ((i = loop->next.fetch_add(1, std::memory_order_relaxed)) < count) {
+            body(i);
+            if (loop->done.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                std::lock_guard lock(loop->mutex);
+                loop->finished.notify_all();
+            }
+        }
+    };
+
+    for (std::size_t i = 1; i < std::min(count, size()); i++)
+        post(work);
+    work();
+    // only indices that other threads are running right now are left
+    std::unique_lock lock(loop->mutex);
+    loop->finished.wait(lock, [&] { return loop->done.load(std::memory_order_acquire) == count; });
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    auto& queue = current_pool == this ? *queues[current_queue] : *queues.back();
+    // counted before it can be taken, so pending never drops below the number of queued tasks
+    pending.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    // taking the lock orders the notification after a sleeping worker's check of pending
+    { std::lock_guard lock(mutex); }
+    ready.notify_one();
+}
+
+bool ThreadPool::take(std::size_t self, std::function<void()>& task) {
+    // own tasks newest first while their data is still in cache, then the outside queue and other workers oldest first
+    {
+        auto& own = *queues[self];
+        std::lock_guard lock(own.mutex);
+        if (not own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i < queues.size(); i++) {
+        auto& victim = *queues[(self + i) % queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if (not victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(std::size_t self) {
+    current_pool = this;
+    current_queue = self;
+    while (true) {
+        std::function<void()> task;
+        if (take(self, task)) {
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            continue;
+        }
+        std::unique_lock lock(mutex);
+        ready.wait(lock, [this] { return stopping or pending.load(std::memory_order_acquire) != 0; });
+        if (stopping and pending.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+}  // namespace cless::core::parallel
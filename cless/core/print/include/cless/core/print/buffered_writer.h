@@ -0,0 +1,38 @@
+#ifndef CLESS_CORE_PRINT_BUFFERED_WRITER_H
+#define CLESS_CORE_PRINT_BUFFERED_WRITER_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace cless::core::print {
+
+// Output to a file descriptor through one large buffer, for dumps that would otherwise pay a system call or a stream
+// flush per line. The buffer is written when it fills up, on flush() and when the writer is destroyed.
+class BufferedWriter {
+    int fd;
+    std::unique_ptr<char[]> buffer;
+    std::size_t capacity;
+    std::size_t used;
+    bool failed_;
+
+public:
+    static constexpr std::size_t default_capacity = 1024 * 1024;
+
+    explicit BufferedWriter(int fd, std::size_t capacity = default_capacity);
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+    ~BufferedWriter();
+
+    void write(std::string_view text);
+    void flush();
+    // whether any write to fd failed
+    bool failed() const;
+
+private:
+    void writeOut(const char *data, std::size_t size);
+};
+
+}  // namespace cless::core::print
+
+#endif
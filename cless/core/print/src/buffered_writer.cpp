@@ -0,0 +1,55 @@
+#include "cless/core/print/buffered_writer.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "cless/core/instrument/instrument.h"
+
+namespace cless::core::print {
+
+BufferedWriter::BufferedWriter(int fd, std::size_t capacity)
+    : fd(fd), buffer(std::make_unique<char[]>(capacity)), capacity(capacity), used(0), failed_(false) {}
+
+BufferedWriter::~BufferedWriter() {
+    flush();
+}
+
+void BufferedWriter::write(std::string_view text) {
+    if (text.size() > capacity - used) {
+        flush();
+        // text that would not fit even into an empty buffer skips it
+        if (text.size() >= capacity)
+            return writeOut(text.data(), text.size());
+    }
+    std::memcpy(buffer.get() + used, text.data(), text.size());
+    used += text.size();
+}
+
+void BufferedWriter::flush() {
+    writeOut(buffer.get(), used);
+    used = 0;
+}
+
+bool BufferedWriter::failed() const {
+    return failed_;
+}
+
+void BufferedWriter::writeOut(const char* data, std::size_t size) {
+    instrument::Timer timer("write output");
+    instrument::count("output bytes", size);
+    while (size > 0 and not failed_) {
+        auto n = ::write(fd, data, size);
+        if (n < 0 and errno == EINTR)
+            continue;
+        if (n < 0) {
+            failed_ = true;
+            break;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+}  // namespace cless::core::print
@@ -0,0 +1,32 @@
+#ifndef CLESS_CORE_SOURCE_LINE_INDEX_H
+#define CLESS_CORE_SOURCE_LINE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace cless::core::source {
+
+// Offsets of the first byte of every line of a text, found with a vectorized newline scan. Lines and columns are
+// 1-based, columns count bytes.
+class LineIndex {
+    std::vector<std::uint32_t> starts;
+
+public:
+    LineIndex();
+    explicit LineIndex(std::string_view text);
+
+    std::size_t lineCount() const;
+    std::uint32_t lineStart(std::size_t line) const;
+
+    std::size_t lineOf(std::uint32_t offset) const;
+    // same as lineOf, but checks hint and the line after it before falling back to a binary search, which makes
+    // lookups in increasing offset order O(1)
+    std::size_t lineOf(std::uint32_t offset, std::size_t hint) const;
+    std::size_t columnOf(std::uint32_t offset, std::size_t line) const;
+};
+
+}  // namespace cless::core::source
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef CLESS_CORE_SOURCE_SCAN_H
+#define CLESS_CORE_SOURCE_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cless::core::source::scan {
+
+// Bulk scanning kernels for the lexer and the line index. They read whole 16 or 32 byte blocks and therefore rely on
+// the zero padding after a SourceBuffer: every kernel stops at '\0', so no block ever starts past the terminator.
+
+enum class Kernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// first byte that is not one of ' ', '\t', '\n', '\v', '\f', '\r'
+const char *skipBlanks(const char *p);
+// first '\n' or '\0'
+const char *findLineEnd(const char *p);
+// first '*' followed by '/', or '\0'
+const char *findCommentEnd(const char *p);
+// first quote, '\\', '\n' or '\0'
+const char *findLiteralEnd(const char *p, char quote);
+// the same for text that ends at end and may hold '\0' bytes before it, which belong to the comment
+const char *findLineEnd(const char *p, const char *end);
+const char *findCommentEnd(const char *p, const char *end);
+std::size_t countNewlines(const char *begin, const char *end);
+// appends the offset from begin of the byte after every '\n' in [begin, end)
+void findLineStarts(const char *begin, const char *end, std::vector<std::uint32_t> &starts);
+
+// The best kernel supported by the running CPU is selected by the first scan, so scanning from a static initializer is
+// safe. useKernel() may switch kernels while other threads scan; each call runs with the old or the new kernel.
+Kernel activeKernel();
+bool isSupported(Kernel kernel);
+void useKernel(Kernel kernel);
+
+}  // namespace cless::core::source::scan
+
+#endif
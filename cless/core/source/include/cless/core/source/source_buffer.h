@@ -0,0 +1,51 @@
+#ifndef CLESS_CORE_SOURCE_SOURCE_BUFFER_H
+#define CLESS_CORE_SOURCE_SOURCE_BUFFER_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace cless::core::source {
+
+// Read-only contents of a source file. Regular files are memory-mapped; anything else (stdin, pipes, strings) is
+// copied to the heap. A non-empty buffer always ends with '\n' and is followed by `padding` zero bytes, so scanners
+// may look a few bytes past the end without bounds checks.
+class SourceBuffer {
+    std::string heap;
+    char *mapping;
+    std::size_t mapping_size;
+    const char *data_;
+    std::size_t size_;
+
+public:
+    static constexpr std::size_t padding = 64;
+
+    SourceBuffer();
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer(SourceBuffer &&other) noexcept;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(SourceBuffer &&other) noexcept;
+    ~SourceBuffer();
+
+    // nullopt with errno set when the file cannot be read
+    static std::optional<SourceBuffer> fromFile(const std::string &path);
+    static std::optional<SourceBuffer> fromDescriptor(int fd);
+    static SourceBuffer fromString(std::string_view str);
+
+    const char *data() const;
+    std::size_t size() const;
+    std::string_view view() const;
+    bool isMapped() const;
+
+private:
+    static std::optional<SourceBuffer> map(int fd, std::size_t size);
+    static std::optional<SourceBuffer> read(int fd);
+
+    void release();
+    void terminate();
+};
+
+}  // namespace cless::core::source
+
+#endif
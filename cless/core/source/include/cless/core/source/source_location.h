@@ -0,0 +1,41 @@
+#ifndef CLESS_CORE_SOURCE_SOURCE_LOCATION_H
+#define CLESS_CORE_SOURCE_SOURCE_LOCATION_H
+
+#include <compare>
+#include <cstdint>
+
+namespace cless::core::source {
+
+// Identifies a buffer registered with a SourceManager. 0 is invalid.
+class FileID {
+    std::uint32_t id;
+
+public:
+    constexpr FileID() : id(0) {}
+    constexpr explicit FileID(std::uint32_t id) : id(id) {}
+
+    constexpr bool isValid() const { return id != 0; }
+    constexpr std::uint32_t value() const { return id; }
+
+    constexpr auto operator<=>(const FileID &) const = default;
+};
+
+// A position in any source registered with a SourceManager, packed in 32 bits. Every file owns a contiguous range of
+// the location space, so a location is the base of its file plus an offset into the physical text. 0 is invalid.
+class SourceLocation {
+    std::uint32_t id;
+
+public:
+    constexpr SourceLocation() : id(0) {}
+    constexpr explicit SourceLocation(std::uint32_t id) : id(id) {}
+
+    constexpr bool isValid() const { return id != 0; }
+    constexpr std::uint32_t value() const { return id; }
+    constexpr SourceLocation withOffset(std::uint32_t offset) const { return SourceLocation(id + offset); }
+
+    constexpr auto operator<=>(const SourceLocation &) const = default;
+};
+
+}  // namespace cless::core::source
+
+#endif
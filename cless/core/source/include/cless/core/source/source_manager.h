@@ -0,0 +1,93 @@
+#ifndef CLESS_CORE_SOURCE_SOURCE_MANAGER_H
+#define CLESS_CORE_SOURCE_SOURCE_MANAGER_H
+
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "cless/core/source/line_index.h"
+#include "cless/core/source/source_buffer.h"
+#include "cless/core/source/source_location.h"
+
+namespace cless::core::source {
+
+// what a SourceLocation means to a user: path, 1-based line and 1-based column
+struct PresumedLocation {
+    std::string_view path;
+    std::size_t line;
+    std::size_t column;
+};
+
+std::ostream &operator<<(std::ostream &os, const PresumedLocation &loc);
+
+// Owns every source buffer of a compilation and maps SourceLocations back to them. Buffers never move once
+// registered, so pointers into them stay valid for the lifetime of the manager. One manager can serve every
+// translation unit of a batch: all members may be called from several threads, and a file that is loaded again, such
+// as a header included by many units, is read only once.
+class SourceManager {
+    struct Entry {
+        std::string path;
+        SourceBuffer buffer;
+        std::uint32_t base;
+        // line of path the buffer starts at, which is not 1 for the later windows of a stream
+        std::size_t first_line;
+        mutable std::once_flag lines_once;
+        mutable std::optional<LineIndex> lines;
+
+        Entry(std::string path, SourceBuffer buffer, std::uint32_t base, std::size_t first_line);
+    };
+
+    mutable std::shared_mutex mutex;
+    std::deque<Entry> entries;
+    std::uint32_t next_base;
+    std::unordered_map<std::string, FileID> loaded;
+    // released files, whose entries and location ranges are handed to later buffers
+    std::vector<FileID> released;
+
+public:
+    SourceManager();
+    SourceManager(const SourceManager &) = delete;
+    SourceManager &operator=(const SourceManager &) = delete;
+
+    // "-" reads stdin. Files are cached by path, stdin is not. The error is an errno value: the one of the failed
+    // system call if the file cannot be read, EFBIG if the location space is exhausted.
+    std::expected<FileID, int> loadFile(const std::string &path);
+    // nullopt once the 32-bit location space is exhausted. first_line is the line of path the buffer starts at, for
+    // a buffer that is one window of a longer stream; it must start at the beginning of that line.
+    std::optional<FileID> addBuffer(std::string path, SourceBuffer buffer, std::size_t first_line = 1);
+    // Frees the text of a file that is no longer read, such as a lexed window of a stream. Its FileID and location
+    // range go to a later buffer that fits in them, so a stream of any length takes a bounded number of entries and
+    // locations; nothing may resolve a location of the released file afterwards.
+    void release(FileID file);
+
+    const std::string &path(FileID file) const;
+    const SourceBuffer &buffer(FileID file) const;
+    SourceLocation startOf(FileID file) const;
+    // line of path the buffer of file starts at
+    std::size_t firstLine(FileID file) const;
+    // built on first use, so files that never need a line number never pay for the newline scan
+    const LineIndex &lineIndex(FileID file) const;
+
+    FileID fileID(SourceLocation loc) const;
+    std::uint32_t offset(SourceLocation loc) const;
+    PresumedLocation decode(SourceLocation loc) const;
+
+private:
+    // addBuffer() with the lock held
+    std::optional<FileID> add(std::string path, SourceBuffer buffer, std::size_t first_line);
+    // a released file whose location range can take span locations, removed from released
+    std::optional<FileID> reuse(std::uint64_t span);
+    const Entry &entry(FileID file) const;
+};
+
+}  // namespace cless::core::source
+
+#endif
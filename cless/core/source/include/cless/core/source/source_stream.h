@@ -0,0 +1,48 @@
+#ifndef CLESS_CORE_SOURCE_SOURCE_STREAM_H
+#define CLESS_CORE_SOURCE_SOURCE_STREAM_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include "cless/core/source/source_buffer.h"
+
+namespace cless::core::source {
+
+// Reads a file descriptor such as stdin or a pipe in windows of whole lines, so the input is never held in memory at
+// once. Reads fill a buffer of fixed size; a window ends after the last newline in it that does not end a
+// backslash-newline, so no line splice and no token but a block comment crosses into the next window. The bytes after
+// that newline move to the front of the buffer and the rest is refilled. Only a line longer than the buffer makes it
+// grow, so memory is bounded by the window size or the longest logical line, not by the input.
+class SourceStream {
+    int fd;
+    std::string buffer;
+    std::size_t filled;
+    std::size_t line;
+    bool eof;
+    bool failed_;
+
+public:
+    static constexpr std::size_t default_window_size = 1024 * 1024;
+
+    // a window of the stream and the line of the stream it starts at
+    struct Window {
+        SourceBuffer text;
+        std::size_t first_line;
+    };
+
+    explicit SourceStream(int fd, std::size_t window_size = default_window_size);
+    SourceStream(const SourceStream &) = delete;
+    SourceStream &operator=(const SourceStream &) = delete;
+
+    // nullopt at the end of the stream or after a read error
+    std::optional<Window> next();
+    bool failed() const;
+
+private:
+    void fill();
+};
+
+}  // namespace cless::core::source
+
+#endif
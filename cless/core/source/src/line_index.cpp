@@ -0,0 +1,46 @@
+#include "cless/core/source/line_index.h"
+
+#include <algorithm>
+
+#include "cless/core/source/scan.h"
+
+namespace cless::core::source {
+
+LineIndex::LineIndex() : starts{0} {}
+
+LineIndex::LineIndex(std::string_view text) : starts{0} {
+    // source code averages somewhere around 30 bytes per line
+    starts.reserve(text.size() / 32 + 1);
+    scan::findLineStarts(text.data(), text.data() + text.size(), starts);
+}
+
+std::size_t LineIndex::lineCount() const {
+    return starts.size();
+}
+
+std::uint32_t LineIndex::lineStart(std::size_t line) const {
+    return starts[line - 1];
+}
+
+std::size_t LineIndex::lineOf(std::uint32_t offset) const {
+    return std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin();
+}
+
+std::size_t LineIndex::lineOf(std::uint32_t offset, std::size_t hint) const {
+    auto contains = [&](std::size_t line) {
+        return starts[line - 1] <= offset and (line == starts.size() or offset < starts[line]);
+    };
+    if (hint >= 1 and hint <= starts.size()) {
+        if (contains(hint))
+            return hint;
+        if (hint < starts.size() and contains(hint + 1))
+            return hint + 1;
+    }
+    return lineOf(offset);
+}
+
+std::size_t LineIndex::columnOf(std::uint32_t offset, std::size_t line) const {
+    return offset - starts[line - 1] + 1;
+}
+
+}  // namespace cless::core::source
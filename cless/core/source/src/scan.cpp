@@ -0,0 +1,386 @@
+#include "cless/core/source/scan.h"
+
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) or defined(__i386__)
+#include <immintrin.h>
+#define CLESS_SCAN_X86
+#endif
+
+namespace cless::core::source::scan {
+
+static bool isBlank(char c) {
+    return c == ' ' or (c >= '\t' and c <= '\r');
+}
+
+static const char* skipBlanksScalar(const char* p) {
+    while (isBlank(*p))
+        p++;
+    return p;
+}
+
+static const char* findLineEndScalar(const char* p) {
+    while (*p != '\n' and *p != '\0')
+        p++;
+    return p;
+}
+
+static const char* findCommentEndScalar(const char* p) {
+    while (*p != '\0' and (*p != '*' or *(p + 1) != '/'))
+        p++;
+    return p;
+}
+
+static const char* findLiteralEndScalar(const char* p, char quote) {
+    while (*p != quote and *p != '\\' and *p != '\n' and *p != '\0')
+        p++;
+    return p;
+}
+
+static std::size_t countNewlinesScalar(const char* begin, const char* end) {
+    std::size_t count = 0;
+    for (const char* p = begin; p < end; p++)
+        count += *p == '\n';
+    return count;
+}
+
+// the line starts of text[begin, end), as offsets from text
+static void appendLineStarts(const char* text, std::size_t begin, std::size_t end, std::vector<std::uint32_t>& starts) {
+    for (std::size_t i = begin; i < end; i++)
+        if (text[i] == '\n')
+            starts.push_back(static_cast<std::uint32_t>(i + 1));
+}
+
+static void findLineStartsScalar(const char* begin, const char* end, std::vector<std::uint32_t>& starts) {
+    appendLineStarts(begin, 0, end - begin, starts);
+}
+
+#ifdef CLESS_SCAN_X86
+
+__attribute__((target("sse2"))) static const char* skipBlanksSse2(const char* p) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i range = _mm_set1_epi8('\r' - '\t');
+    while (true) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i t = _mm_sub_epi8(v, tab);
+        __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(_mm_min_epu8(t, range), t));
+        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFF;
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 16;
+    }
+}
+
+__attribute__((target("sse2"))) static const char* findLineEndSse2(const char* p) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i zero = _mm_setzero_si128();
+    while (true) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, zero)));
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 16;
+    }
+}
+
+__attribute__((target("sse2"))) static const char* findCommentEndSse2(const char* p) {
+    const __m128i star = _mm_set1_epi8('*');
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i zero = _mm_setzero_si128();
+    while (true) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+        __m128i end = _mm_and_si128(_mm_cmpeq_epi8(v, star), _mm_cmpeq_epi8(w, slash));
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(end, _mm_cmpeq_epi8(v, zero)));
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 16;
+    }
+}
+
+__attribute__((target("sse2"))) static const char* findLiteralEndSse2(const char* p, char quote) {
+    const __m128i closing = _mm_set1_epi8(quote);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i zero = _mm_setzero_si128();
+    while (true) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i end = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, closing), _mm_cmpeq_epi8(v, backslash)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, zero)));
+        unsigned mask = _mm_movemask_epi8(end);
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 16;
+    }
+}
+
+// SSE2 does not imply popcnt, so the bits are counted without it
+__attribute__((target("sse2"))) static std::size_t countNewlinesSse2(const char* begin, const char* end) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    std::size_t count = 0;
+    const char* p = begin;
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        count += std::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline))));
+    }
+    return count + countNewlinesScalar(p, end);
+}
+
+__attribute__((target("sse2"))) static void findLineStartsSse2(
+    const char* begin,
+    const char* end,
+    std::vector<std::uint32_t>& starts) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    std::size_t size = end - begin;
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + i));
+        unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, newline));
+        while (mask != 0) {
+            starts.push_back(static_cast<std::uint32_t>(i + __builtin_ctz(mask) + 1));
+            mask &= mask - 1;
+        }
+    }
+    appendLineStarts(begin, i, size, starts);
+}
+
+__attribute__((target("avx2"))) static const char* skipBlanksAvx2(const char* p) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i range = _mm256_set1_epi8('\r' - '\t');
+    while (true) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i t = _mm256_sub_epi8(v, tab);
+        __m256i blank =
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(_mm256_min_epu8(t, range), t));
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(blank));
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 32;
+    }
+}
+
+__attribute__((target("avx2"))) static const char* findLineEndAvx2(const char* p) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i zero = _mm256_setzero_si256();
+    while (true) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned mask =
+            _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, newline), _mm256_cmpeq_epi8(v, zero)));
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 32;
+    }
+}
+
+__attribute__((target("avx2"))) static const char* findCommentEndAvx2(const char* p) {
+    const __m256i star = _mm256_set1_epi8('*');
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i zero = _mm256_setzero_si256();
+    while (true) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+        __m256i end = _mm256_and_si256(_mm256_cmpeq_epi8(v, star), _mm256_cmpeq_epi8(w, slash));
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(end, _mm256_cmpeq_epi8(v, zero)));
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 32;
+    }
+}
+
+__attribute__((target("avx2"))) static const char* findLiteralEndAvx2(const char* p, char quote) {
+    const __m256i closing = _mm256_set1_epi8(quote);
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i zero = _mm256_setzero_si256();
+    while (true) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i end = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, closing), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, newline), _mm256_cmpeq_epi8(v, zero)));
+        unsigned mask = _mm256_movemask_epi8(end);
+        if (mask != 0)
+            return p + __builtin_ctz(mask);
+        p += 32;
+    }
+}
+
+__attribute__((target("avx2,popcnt"))) static std::size_t countNewlinesAvx2(const char* begin, const char* end) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    std::size_t count = 0;
+    const char* p = begin;
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline))));
+    }
+    return count + countNewlinesScalar(p, end);
+}
+
+__attribute__((target("avx2"))) static void findLineStartsAvx2(
+    const char* begin,
+    const char* end,
+    std::vector<std::uint32_t>& starts) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    std::size_t size = end - begin;
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+        while (mask != 0) {
+            starts.push_back(static_cast<std::uint32_t>(i + __builtin_ctz(mask) + 1));
+            mask &= mask - 1;
+        }
+    }
+    appendLineStarts(begin, i, size, starts);
+}
+
+#endif
+
+struct Kernels {
+    Kernel kernel;
+    const char* (*skip_blanks)(const char*);
+    const char* (*find_line_end)(const char*);
+    const char* (*find_comment_end)(const char*);
+    const char* (*find_literal_end)(const char*, char);
+    std::size_t (*count_newlines)(const char*, const char*);
+    void (*find_line_starts)(const char*, const char*, std::vector<std::uint32_t>&);
+};
+
+#ifdef CLESS_SCAN_X86
+static constexpr Kernels avx2_kernels = {
+    Kernel::Avx2,
+    skipBlanksAvx2,
+    findLineEndAvx2,
+    findCommentEndAvx2,
+    findLiteralEndAvx2,
+    countNewlinesAvx2,
+    findLineStartsAvx2};
+static constexpr Kernels sse2_kernels = {
+    Kernel::Sse2,
+    skipBlanksSse2,
+    findLineEndSse2,
+    findCommentEndSse2,
+    findLiteralEndSse2,
+    countNewlinesSse2,
+    findLineStartsSse2};
+#endif
+static constexpr Kernels scalar_kernels = {
+    Kernel::Scalar,
+    skipBlanksScalar,
+    findLineEndScalar,
+    findCommentEndScalar,
+    findLiteralEndScalar,
+    countNewlinesScalar,
+    findLineStartsScalar};
+
+static const Kernels* kernelsFor(Kernel kernel) {
+    switch (kernel) {
+#ifdef CLESS_SCAN_X86
+        case Kernel::Avx2:
+            return &avx2_kernels;
+        case Kernel::Sse2:
+            return &sse2_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
+
+static const Kernels* bestKernels() {
+    if (isSupported(Kernel::Avx2))
+        return kernelsFor(Kernel::Avx2);
+    if (isSupported(Kernel::Sse2))
+        return kernelsFor(Kernel::Sse2);
+    return kernelsFor(Kernel::Scalar);
+}
+
+// A function-local static, so the kernels are selected on first use, also by a lexer that runs from the static
+// initializer of another translation unit. The tables are constants and useKernel() only swaps the pointer, so threads
+// that scan meanwhile run with one set or the other.
+static std::atomic<const Kernels*>& selected() {
+    static std::atomic<const Kernels*> kernels{bestKernels()};
+    return kernels;
+}
+
+static const Kernels& active() {
+    return *selected().load(std::memory_order_relaxed);
+}
+
+const char* skipBlanks(const char* p) {
+    // most runs between tokens are a single space, which is not worth a vector load
+    if (not isBlank(*p))
+        return p;
+    if (not isBlank(*(p + 1)))
+        return p + 1;
+    return active().skip_blanks(p + 2);
+}
+
+const char* findLineEnd(const char* p) {
+    return active().find_line_end(p);
+}
+
+const char* findCommentEnd(const char* p) {
+    return active().find_comment_end(p);
+}
+
+const char* findLiteralEnd(const char* p, char quote) {
+    return active().find_literal_end(p, quote);
+}
+
+const char* findLineEnd(const char* p, const char* end) {
+    p = findLineEnd(p);
+    while (*p == '\0' and p < end)
+        p = findLineEnd(p + 1);
+    return p;
+}
+
+const char* findCommentEnd(const char* p, const char* end) {
+    p = findCommentEnd(p);
+    while (*p == '\0' and p < end)
+        p = findCommentEnd(p + 1);
+    return p;
+}
+
+std::size_t countNewlines(const char* begin, const char* end) {
+    if (end - begin < 16)
+        return countNewlinesScalar(begin, end);
+    return active().count_newlines(begin, end);
+}
+
+void findLineStarts(const char* begin, const char* end, std::vector<std::uint32_t>& starts) {
+    active().find_line_starts(begin, end, starts);
+}
+
+Kernel activeKernel() {
+    return active().kernel;
+}
+
+bool isSupported(Kernel kernel) {
+#ifdef CLESS_SCAN_X86
+    // may run from a static initializer, before the cpu model is set up
+    __builtin_cpu_init();
+#endif
+    switch (kernel) {
+        case Kernel::Scalar:
+            return true;
+#ifdef CLESS_SCAN_X86
+        case Kernel::Sse2:
+            return __builtin_cpu_supports("sse2");
+        case Kernel::Avx2:
+            // the AVX2 newline count is built with popcnt
+            return __builtin_cpu_supports("avx2") and __builtin_cpu_supports("popcnt");
+#endif
+        default:
+            return false;
+    }
+}
+
+void useKernel(Kernel kernel) {
+    if (isSupported(kernel))
+        selected().store(kernelsFor(kernel), std::memory_order_relaxed);
+}
+
+}  // namespace cless::core::source::scan
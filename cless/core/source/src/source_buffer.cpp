@@ -0,0 +1,164 @@
+#include "cless/core/source/source_buffer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+namespace cless::core::source {
+
+SourceBuffer::SourceBuffer() : mapping(nullptr), mapping_size(0), data_(nullptr), size_(0) {
+    terminate();
+}
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept
+    : heap(std::move(other.heap)),
+      mapping(std::exchange(other.mapping, nullptr)),
+      mapping_size(std::exchange(other.mapping_size, 0)),
+      data_(mapping != nullptr ? mapping : heap.data()),
+      size_(std::exchange(other.size_, 0)) {
+    other.heap.clear();
+    other.data_ = other.heap.data();
+}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        heap = std::move(other.heap);
+        mapping = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+        data_ = mapping != nullptr ? mapping : heap.data();
+        size_ = std::exchange(other.size_, 0);
+        other.heap.clear();
+        other.data_ = other.heap.data();
+    }
+    return *this;
+}
+
+SourceBuffer::~SourceBuffer() {
+    release();
+}
+
+std::optional<SourceBuffer> SourceBuffer::fromFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return std::nullopt;
+    auto buffer = fromDescriptor(fd);
+    int error = errno;
+    ::close(fd);
+    errno = error;
+    return buffer;
+}
+
+std::optional<SourceBuffer> SourceBuffer::fromDescriptor(int fd) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+        return std::nullopt;
+    if (S_ISDIR(st.st_mode)) {
+        errno = EISDIR;
+        return std::nullopt;
+    }
+    if (S_ISREG(st.st_mode) and st.st_size > 0) {
+        if (auto buffer = map(fd, static_cast<std::size_t>(st.st_size)); buffer.has_value())
+            return buffer;
+    }
+    return read(fd);
+}
+
+SourceBuffer SourceBuffer::fromString(std::string_view str) {
+    SourceBuffer buffer;
+    buffer.heap.assign(str);
+    buffer.size_ = str.size();
+    buffer.terminate();
+    return buffer;
+}
+
+const char* SourceBuffer::data() const {
+    return data_;
+}
+
+std::size_t SourceBuffer::size() const {
+    return size_;
+}
+
+std::string_view SourceBuffer::view() const {
+    return {data_, size_};
+}
+
+bool SourceBuffer::isMapped() const {
+    return mapping != nullptr;
+}
+
+std::optional<SourceBuffer> SourceBuffer::map(int fd, std::size_t size) {
+    // reserve anonymous zero pages for the whole region first, then map the file over its head; the tail of the last
+    // file page is zero-filled by the kernel and the pages after it stay anonymous, so the padding never faults
+    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto total = (size + 1 + padding + page - 1) / page * page;
+    void* base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return std::nullopt;
+    if (::mmap(base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        ::munmap(base, total);
+        return std::nullopt;
+    }
+    ::madvise(base, size, MADV_SEQUENTIAL | MADV_WILLNEED);
+
+    SourceBuffer buffer;
+    buffer.mapping = static_cast<char*>(base);
+    buffer.mapping_size = total;
+    buffer.data_ = buffer.mapping;
+    buffer.size_ = size;
+    buffer.terminate();
+    return buffer;
+}
+
+std::optional<SourceBuffer> SourceBuffer::read(int fd) {
+    SourceBuffer buffer;
+    std::size_t size = 0;
+    while (true) {
+        if (buffer.heap.size() - size < 4096)
+            buffer.heap.resize(std::max<std::size_t>(buffer.heap.size() * 2, 65536));
+        auto n = ::read(fd, buffer.heap.data() + size, buffer.heap.size() - size);
+        if (n < 0 and errno == EINTR)
+            continue;
+        if (n < 0)
+            return std::nullopt;
+        if (n == 0)
+            break;
+        size += static_cast<std::size_t>(n);
+    }
+    buffer.heap.resize(size);
+    buffer.size_ = size;
+    buffer.terminate();
+    return buffer;
+}
+
+void SourceBuffer::release() {
+    if (mapping != nullptr)
+        ::munmap(mapping, mapping_size);
+    mapping = nullptr;
+    mapping_size = 0;
+}
+
+void SourceBuffer::terminate() {
+    if (mapping != nullptr) {
+        // the mapping is private and writable, so this touches at most one copy-on-write page
+        if (mapping[size_ - 1] != '\n')
+            mapping[size_++] = '\n';
+        data_ = mapping;
+        return;
+    }
+    if (size_ > 0 and heap[size_ - 1] != '\n') {
+        heap.resize(size_);
+        heap.push_back('\n');
+        size_++;
+    }
+    heap.resize(size_ + padding, '\0');
+    data_ = heap.data();
+}
+
+}  // namespace cless::core::source
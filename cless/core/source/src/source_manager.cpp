@@ -0,0 +1,163 @@
+#include "cless/core/source/source_manager.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <memory>
+
+#include "cless/core/instrument/instrument.h"
+
+namespace cless::core::source {
+
+std::ostream& operator<<(std::ostream& os, const PresumedLocation& loc) {
+    return os << loc.path << ":" << loc.line << ":" << loc.column;
+}
+
+SourceManager::Entry::Entry(std::string path, SourceBuffer buffer, std::uint32_t base, std::size_t first_line)
+    : path(std::move(path)), buffer(std::move(buffer)), base(base), first_line(first_line) {}
+
+SourceManager::SourceManager() : next_base(1) {}
+
+std::expected<FileID, int> SourceManager::loadFile(const std::string& path) {
+    instrument::Timer timer("load file", path);
+    if (path == "-") {
+        auto buffer = SourceBuffer::fromDescriptor(STDIN_FILENO);
+        if (not buffer.has_value())
+            return std::unexpected(errno);
+        if (auto file = addBuffer(path, std::move(buffer.value())); file.has_value())
+            return file.value();
+        return std::unexpected(EFBIG);
+    }
+    {
+        std::shared_lock lock(mutex);
+        if (auto it = loaded.find(path); it != loaded.end())
+            return it->second;
+    }
+    // read without the lock; when two threads race for the same file, the first one to register it wins
+    auto buffer = SourceBuffer::fromFile(path);
+    if (not buffer.has_value())
+        return std::unexpected(errno);
+    std::unique_lock lock(mutex);
+    if (auto it = loaded.find(path); it != loaded.end())
+        return it->second;
+    auto file = add(path, std::move(buffer.value()), 1);
+    if (not file.has_value())
+        return std::unexpected(EFBIG);
+    loaded.emplace(path, file.value());
+    return file.value();
+}
+
+std::optional<FileID> SourceManager::addBuffer(std::string path, SourceBuffer buffer, std::size_t first_line) {
+    std::unique_lock lock(mutex);
+    return add(std::move(path), std::move(buffer), first_line);
+}
+
+void SourceManager::release(FileID file) {
+    std::unique_lock lock(mutex);
+    auto& e = entries[file.value() - 1];
+    // a line index that was never built stays empty instead of being built from the released text
+    std::call_once(e.lines_once, [&e] { e.lines.emplace(); });
+    e.lines.emplace();
+    e.buffer = SourceBuffer();
+    std::erase_if(loaded, [file](const auto& item) { return item.second == file; });
+    released.push_back(file);
+}
+
+std::optional<FileID> SourceManager::add(std::string path, SourceBuffer buffer, std::size_t first_line) {
+    // one extra location per file so that the end of a file is distinct from the start of the next one
+    std::uint64_t span = static_cast<std::uint64_t>(buffer.size()) + 1;
+    if (auto file = reuse(span); file.has_value()) {
+        // the once flag of the line index cannot be reset, so the entry is made anew in its place
+        auto& e = entries[file->value() - 1];
+        auto base = e.base;
+        std::destroy_at(&e);
+        std::construct_at(&e, std::move(path), std::move(buffer), base, first_line);
+        return file;
+    }
+    if (span > std::numeric_limits<std::uint32_t>::max() - next_base)
+        return std::nullopt;
+    entries.emplace_back(std::move(path), std::move(buffer), next_base, first_line);
+    next_base += static_cast<std::uint32_t>(span);
+    return FileID(static_cast<std::uint32_t>(entries.size()));
+}
+
+std::optional<FileID> SourceManager::reuse(std::uint64_t span) {
+    for (auto it = released.begin(); it != released.end(); ++it) {
+        std::size_t index = it->value() - 1;
+        std::uint32_t base = entries[index].base;
+        bool last = index + 1 == entries.size();
+        // the range of a file ends where the next one starts, but the last one can grow into the unused space
+        std::uint64_t end = last ? std::numeric_limits<std::uint32_t>::max() : entries[index + 1].base;
+        if (span > end - base)
+            continue;
+        if (last)
+            next_base = static_cast<std::uint32_t>(base + span);
+        auto file = *it;
+        *it = released.back();
+        released.pop_back();
+        return file;
+    }
+    return std::nullopt;
+}
+
+const SourceManager::Entry& SourceManager::entry(FileID file) const {
+    // entries never move, so the reference stays good after the lock is released
+    std::shared_lock lock(mutex);
+    return entries[file.value() - 1];
+}
+
+const std::string& SourceManager::path(FileID file) const {
+    return entry(file).path;
+}
+
+const SourceBuffer& SourceManager::buffer(FileID file) const {
+    return entry(file).buffer;
+}
+
+SourceLocation SourceManager::startOf(FileID file) const {
+    return SourceLocation(entry(file).base);
+}
+
+std::size_t SourceManager::firstLine(FileID file) const {
+    return entry(file).first_line;
+}
+
+const LineIndex& SourceManager::lineIndex(FileID file) const {
+    const auto& e = entry(file);
+    std::call_once(e.lines_once, [&e] {
+        instrument::Timer timer("line index", e.path);
+        e.lines.emplace(e.buffer.view());
+    });
+    return e.lines.value();
+}
+
+FileID SourceManager::fileID(SourceLocation loc) const {
+    if (not loc.isValid())
+        return FileID();
+    std::shared_lock lock(mutex);
+    auto it = std::upper_bound(entries.begin(), entries.end(), loc.value(), [](std::uint32_t value, const Entry& e) {
+        return value < e.base;
+    });
+    if (it == entries.begin())
+        return FileID();
+    return FileID(static_cast<std::uint32_t>(it - entries.begin()));
+}
+
+std::uint32_t SourceManager::offset(SourceLocation loc) const {
+    return loc.value() - entry(fileID(loc)).base;
+}
+
+PresumedLocation SourceManager::decode(SourceLocation loc) const {
+    auto file = fileID(loc);
+    if (not file.isValid())
+        return {"<unknown>", 0, 0};
+    const auto& e = entry(file);
+    const auto& lines = lineIndex(file);
+    auto offset = loc.value() - e.base;
+    auto line = lines.lineOf(offset);
+    return {e.path, e.first_line + line - 1, lines.columnOf(offset, line)};
+}
+
+}  // namespace cless::core::source
@@ -0,0 +1,68 @@
+#include "cless/core/source/source_stream.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "cless/core/instrument/instrument.h"
+
+namespace cless::core::source {
+
+// after the last newline of [text, text + size) that is not spliced to the next line, or 0 if there is none
+static std::size_t lastLineEnd(const char* text, std::size_t size) {
+    while (size > 0) {
+        auto newline = static_cast<const char*>(::memrchr(text, '\n', size));
+        if (newline == nullptr)
+            return 0;
+        if (newline == text or newline[-1] != '\\')
+            return newline - text + 1;
+        size = newline - text;
+    }
+    return 0;
+}
+
+SourceStream::SourceStream(int fd, std::size_t window_size)
+    : fd(fd), buffer(window_size, '\0'), filled(0), line(1), eof(false), failed_(false) {}
+
+std::optional<SourceStream::Window> SourceStream::next() {
+    instrument::Timer timer("read window");
+    std::size_t cut;
+    while (true) {
+        fill();
+        cut = eof ? filled : lastLineEnd(buffer.data(), filled);
+        if (cut != 0 or eof)
+            break;
+        // a single line fills the whole buffer, so it has to grow to hold the line
+        buffer.resize(buffer.size() * 2);
+    }
+    if (cut == 0)
+        return std::nullopt;
+
+    Window window{SourceBuffer::fromString({buffer.data(), cut}), line};
+    line += std::count(buffer.data(), buffer.data() + cut, '\n');
+    std::memmove(buffer.data(), buffer.data() + cut, filled - cut);
+    filled -= cut;
+    return window;
+}
+
+bool SourceStream::failed() const {
+    return failed_;
+}
+
+void SourceStream::fill() {
+    while (not eof and filled < buffer.size()) {
+        auto n = ::read(fd, buffer.data() + filled, buffer.size() - filled);
+        if (n < 0 and errno == EINTR)
+            continue;
+        if (n <= 0) {
+            failed_ = n < 0;
+            eof = true;
+            break;
+        }
+        filled += static_cast<std::size_t>(n);
+    }
+}
+
+}  // namespace cless::core::source
@@ -0,0 +1,33 @@
+#ifndef CLESS_CORE_TYPES_ARENA_H
+#define CLESS_CORE_TYPES_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace cless::core::types {
+
+// Bump allocator for text that lives as long as its owner, such as decoded string literals and interned spellings.
+// Copied text never moves, so views into an arena stay valid until it is destroyed, also when the arena itself is
+// moved.
+class Arena {
+    static constexpr std::size_t block_size = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *block_ptr;
+    std::size_t block_left;
+
+public:
+    Arena();
+    Arena(Arena &&other) noexcept;
+    Arena &operator=(Arena &&other) noexcept;
+
+    std::string_view copy(std::string_view text);
+    // takes over the blocks of other, so views into either arena stay valid as long as this one
+    void merge(Arena &&other);
+};
+
+}  // namespace cless::core::types
+
+#endif
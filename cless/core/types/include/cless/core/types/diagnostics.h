@@ -0,0 +1,43 @@
+#ifndef CLESS_CORE_TYPES_DIAGNOSTICS_H
+#define CLESS_CORE_TYPES_DIAGNOSTICS_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+#include "cless/core/types/message.h"
+
+namespace cless::core::types {
+
+// Single place every stage reports its messages to. Messages are counted by severity and handed to a sink, which
+// decides whether to print, store or drop them.
+class DiagnosticsEngine {
+public:
+    using Sink = std::function<void(const Message &)>;
+
+private:
+    Sink sink;
+    std::array<std::size_t, 3> counts;
+    std::size_t error_limit;
+    bool warnings_as_errors;
+    bool limit_reached;
+
+public:
+    explicit DiagnosticsEngine(Sink sink);
+
+    void report(Message msg);
+
+    std::size_t count(Message::Type type) const;
+    std::size_t errorCount() const;
+    std::size_t warningCount() const;
+    bool hasErrors() const;
+
+    // 0 means no limit; once the limit is reached every further message is dropped
+    void setErrorLimit(std::size_t limit);
+    void setWarningsAsErrors(bool enable);
+    bool limitReached() const;
+};
+
+}  // namespace cless::core::types
+
+#endif
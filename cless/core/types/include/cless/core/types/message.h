@@ -4,6 +4,8 @@
 #include <ostream>
 #include <string>
 
+#include "cless/core/source/source_manager.h"
+
 namespace cless::core::types {
 
 struct Message {
@@ -14,17 +16,16 @@ struct Message {
     };
 
     Type type;
-    std::string file;
-    std::size_t line;
-    std::size_t column;
+    source::SourceLocation location;
     std::string message;
 
-    static Message note(std::string file, std::size_t line, std::size_t column, std::string message);
-    static Message warning(std::string file, std::size_t line, std::size_t column, std::string message);
-    static Message error(std::string file, std::size_t line, std::size_t column, std::string message);
+    static Message note(source::SourceLocation location, std::string message);
+    static Message warning(source::SourceLocation location, std::string message);
+    static Message error(source::SourceLocation location, std::string message);
 };
 
-std::ostream &operator<<(std::ostream &os, const Message &msg);
+// the location is decoded to path:line:column only here
+std::ostream &printMessage(std::ostream &os, const Message &msg, const source::SourceManager &sources);
 
 }  // namespace cless::core::types
 
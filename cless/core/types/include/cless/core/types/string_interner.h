@@ -0,0 +1,105 @@
+#ifndef CLESS_CORE_TYPES_STRING_INTERNER_H
+#define CLESS_CORE_TYPES_STRING_INTERNER_H
+
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "cless/core/types/arena.h"
+
+namespace cless::core::types {
+
+// Stable 32-bit handle of an interned string; equal spellings get equal symbols. 0 is invalid.
+class Symbol {
+    std::uint32_t id;
+
+public:
+    constexpr Symbol() : id(0) {}
+    constexpr explicit Symbol(std::uint32_t id) : id(id) {}
+
+    constexpr bool isValid() const { return id != 0; }
+    constexpr std::uint32_t value() const { return id; }
+
+    constexpr auto operator<=>(const Symbol &) const = default;
+};
+
+// Maps spellings to Symbols. It can be shared between threads: lookups of strings that are already interned take no
+// lock, and inserts only lock one of the shards. Interned spellings stay valid as long as the interner.
+class StringInterner {
+public:
+    // 64-bit FNV-1a, exposed so a scanner can hash a spelling while it reads it
+    static constexpr std::uint64_t hash_seed = 0xcbf29ce484222325;
+    static constexpr std::uint64_t hashStep(std::uint64_t hash, char c) {
+        return (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+    }
+    static constexpr std::uint64_t hash(std::string_view str) {
+        std::uint64_t h = hash_seed;
+        for (char c : str)
+            h = hashStep(h, c);
+        return h;
+    }
+
+private:
+    static constexpr std::size_t shard_bits = 4;
+    static constexpr std::size_t shard_count = std::size_t(1) << shard_bits;
+    static constexpr std::size_t first_segment_size = 64;
+
+    struct Entry {
+        std::string_view spelling;
+        std::uint64_t hash;
+        Symbol symbol;
+    };
+
+    // open addressing; a slot is written once and never cleared, so readers can probe without a lock
+    struct Table {
+        std::size_t mask;
+        std::unique_ptr<std::atomic<const Entry *>[]> slots;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::atomic<const Table *> table;
+        std::atomic<std::uint32_t> count;
+        // segment k holds first_segment_size << k entries, so entries never move once written
+        std::array<std::atomic<Entry *>, 32> segments;
+
+        // owned storage, only touched under the mutex; replaced tables are kept alive for concurrent readers
+        std::vector<std::unique_ptr<Table>> tables;
+        std::vector<std::unique_ptr<Entry[]>> segment_storage;
+        Arena spellings;
+    };
+
+    std::array<Shard, shard_count> shards;
+
+public:
+    StringInterner();
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+
+    Symbol intern(std::string_view str);
+    // hash must be hash(str)
+    Symbol intern(std::string_view str, std::uint64_t hash);
+    // invalid Symbol if str was never interned
+    Symbol find(std::string_view str) const;
+
+    std::string_view spelling(Symbol symbol) const;
+    std::size_t size() const;
+
+private:
+    static std::uint64_t mix(std::uint64_t hash);
+    static const Entry *probe(const Table &table, std::string_view str, std::uint64_t hash);
+    static void place(Table &table, const Entry *entry);
+
+    Entry &allocate(Shard &shard, std::uint32_t index);
+    void grow(Shard &shard);
+};
+
+}  // namespace cless::core::types
+
+#endif
@@ -0,0 +1,53 @@
+#include "cless/core/types/arena.h"
+
+#include <cstring>
+#include <utility>
+
+namespace cless::core::types {
+
+Arena::Arena() : block_ptr(nullptr), block_left(0) {}
+
+Arena::Arena(Arena&& other) noexcept
+    : blocks(std::move(other.blocks)),
+      block_ptr(std::exchange(other.block_ptr, nullptr)),
+      block_left(std::exchange(other.block_left, 0)) {}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    blocks = std::move(other.blocks);
+    block_ptr = std::exchange(other.block_ptr, nullptr);
+    block_left = std::exchange(other.block_left, 0);
+    return *this;
+}
+
+std::string_view Arena::copy(std::string_view text) {
+    if (text.empty())
+        return {};
+    char* dest;
+    // large texts get a block of their own so they do not waste the rest of the current one
+    if (text.size() > block_size / 4) {
+        blocks.push_back(std::make_unique<char[]>(text.size()));
+        dest = blocks.back().get();
+    } else {
+        if (block_left < text.size()) {
+            blocks.push_back(std::make_unique<char[]>(block_size));
+            block_ptr = blocks.back().get();
+            block_left = block_size;
+        }
+        dest = block_ptr;
+        block_ptr += text.size();
+        block_left -= text.size();
+    }
+    std::memcpy(dest, text.data(), text.size());
+    return {dest, text.size()};
+}
+
+void Arena::merge(Arena&& other) {
+    // keep allocating from the current block; the other arena's partly used block is just kept alive
+    for (auto& block : other.blocks)
+        blocks.push_back(std::move(block));
+    other.blocks.clear();
+    other.block_ptr = nullptr;
+    other.block_left = 0;
+}
+
+}  // namespace cless::core::types
@@ -0,0 +1,53 @@
+#include "cless/core/types/diagnostics.h"
+
+#include "cless/core/instrument/instrument.h"
+
+namespace cless::core::types {
+
+DiagnosticsEngine::DiagnosticsEngine(Sink sink)
+    : sink(std::move(sink)), counts{}, error_limit(0), warnings_as_errors(false), limit_reached(false) {}
+
+void DiagnosticsEngine::report(Message msg) {
+    if (limit_reached)
+        return;
+    if (msg.type == Message::Type::Warning and warnings_as_errors)
+        msg.type = Message::Type::Error;
+    counts[static_cast<std::size_t>(msg.type)]++;
+    instrument::count("diagnostics");
+    if (sink) {
+        instrument::Timer timer("diagnostics");
+        sink(msg);
+    }
+    if (error_limit != 0 and errorCount() >= error_limit)
+        limit_reached = true;
+}
+
+std::size_t DiagnosticsEngine::count(Message::Type type) const {
+    return counts[static_cast<std::size_t>(type)];
+}
+
+std::size_t DiagnosticsEngine::errorCount() const {
+    return count(Message::Type::Error);
+}
+
+std::size_t DiagnosticsEngine::warningCount() const {
+    return count(Message::Type::Warning);
+}
+
+bool DiagnosticsEngine::hasErrors() const {
+    return errorCount() != 0;
+}
+
+void DiagnosticsEngine::setErrorLimit(std::size_t limit) {
+    error_limit = limit;
+}
+
+void DiagnosticsEngine::setWarningsAsErrors(bool enable) {
+    warnings_as_errors = enable;
+}
+
+bool DiagnosticsEngine::limitReached() const {
+    return limit_reached;
+}
+
+}  // namespace cless::core::types
@@ -4,20 +4,20 @@
 
 namespace cless::core::types {
 
-Message Message::note(std::string file, std::size_t line, std::size_t column, std::string message) {
-    return {Type::Note, std::move(file), line, column, std::move(message)};
+Message Message::note(source::SourceLocation location, std::string message) {
+    return {Type::Note, location, std::move(message)};
 }
 
-Message Message::warning(std::string file, std::size_t line, std::size_t column, std::string message) {
-    return {Type::Warning, std::move(file), line, column, std::move(message)};
+Message Message::warning(source::SourceLocation location, std::string message) {
+    return {Type::Warning, location, std::move(message)};
 }
 
-Message Message::error(std::string file, std::size_t line, std::size_t column, std::string message) {
-    return {Type::Error, std::move(file), line, column, std::move(message)};
+Message Message::error(source::SourceLocation location, std::string message) {
+    return {Type::Error, location, std::move(message)};
 }
 
-std::ostream &operator<<(std::ostream &os, const Message &msg) {
-    os << print::Bold << msg.file << ":" << msg.line << ":" << msg.column << ": ";
+std::ostream &printMessage(std::ostream &os, const Message &msg, const source::SourceManager &sources) {
+    os << print::Bold << sources.decode(msg.location) << ": ";
     switch (msg.type) {
         case Message::Type::Note:
             os << print::Cyan << "note:";
@@ -0,0 +1,122 @@
+#include "cless/core/types/string_interner.h"
+
+#include <bit>
+
+namespace cless::core::types {
+
+static std::pair<std::size_t, std::size_t> segmentOf(std::size_t index, std::size_t first_segment_size) {
+    // segment k starts at first_segment_size * (2^k - 1)
+    std::size_t k = std::bit_width(index / first_segment_size + 1) - 1;
+    return {k, index - first_segment_size * ((std::size_t(1) << k) - 1)};
+}
+
+StringInterner::StringInterner() {
+    for (auto& shard : shards) {
+        auto table = std::make_unique<Table>();
+        table->mask = 63;
+        table->slots = std::make_unique<std::atomic<const Entry*>[]>(64);
+        shard.table.store(table.get(), std::memory_order_relaxed);
+        shard.tables.push_back(std::move(table));
+        shard.count.store(0, std::memory_order_relaxed);
+        for (auto& segment : shard.segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t StringInterner::mix(std::uint64_t hash) {
+    // FNV leaves the high bits weak for short strings, and those pick the shard
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccd;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+const StringInterner::Entry* StringInterner::probe(const Table& table, std::string_view str, std::uint64_t hash) {
+    for (std::size_t i = hash & table.mask;; i = (i + 1) & table.mask) {
+        const Entry* entry = table.slots[i].load(std::memory_order_acquire);
+        if (entry == nullptr)
+            return nullptr;
+        if (entry->hash == hash and entry->spelling == str)
+            return entry;
+    }
+}
+
+void StringInterner::place(Table& table, const Entry* entry) {
+    std::size_t i = entry->hash & table.mask;
+    while (table.slots[i].load(std::memory_order_relaxed) != nullptr)
+        i = (i + 1) & table.mask;
+    table.slots[i].store(entry, std::memory_order_release);
+}
+
+Symbol StringInterner::intern(std::string_view str) {
+    return intern(str, hash(str));
+}
+
+Symbol StringInterner::intern(std::string_view str, std::uint64_t hash) {
+    hash = mix(hash);
+    auto shard_index = hash >> (64 - shard_bits);
+    auto& shard = shards[shard_index];
+    if (const Entry* entry = probe(*shard.table.load(std::memory_order_acquire), str, hash))
+        return entry->symbol;
+
+    std::lock_guard lock(shard.mutex);
+    // another thread may have inserted it, possibly into a grown table
+    if (const Entry* entry = probe(*shard.table.load(std::memory_order_relaxed), str, hash))
+        return entry->symbol;
+
+    auto index = shard.count.load(std::memory_order_relaxed);
+    auto& entry = allocate(shard, index);
+    entry.spelling = shard.spellings.copy(str);
+    entry.hash = hash;
+    entry.symbol = Symbol(((index + 1) << shard_bits) | static_cast<std::uint32_t>(shard_index));
+
+    if ((index + 1) * 2 > shard.table.load(std::memory_order_relaxed)->mask + 1)
+        grow(shard);
+    place(*shard.tables.back(), &entry);
+    shard.count.store(index + 1, std::memory_order_release);
+    return entry.symbol;
+}
+
+Symbol StringInterner::find(std::string_view str) const {
+    auto hash = mix(StringInterner::hash(str));
+    const auto& shard = shards[hash >> (64 - shard_bits)];
+    if (const Entry* entry = probe(*shard.table.load(std::memory_order_acquire), str, hash))
+        return entry->symbol;
+    return Symbol();
+}
+
+std::string_view StringInterner::spelling(Symbol symbol) const {
+    const auto& shard = shards[symbol.value() & (shard_count - 1)];
+    auto [segment, offset] = segmentOf((symbol.value() >> shard_bits) - 1, first_segment_size);
+    return shard.segments[segment].load(std::memory_order_acquire)[offset].spelling;
+}
+
+std::size_t StringInterner::size() const {
+    std::size_t size = 0;
+    for (const auto& shard : shards)
+        size += shard.count.load(std::memory_order_relaxed);
+    return size;
+}
+
+StringInterner::Entry& StringInterner::allocate(Shard& shard, std::uint32_t index) {
+    auto [segment, offset] = segmentOf(index, first_segment_size);
+    if (offset == 0) {
+        shard.segment_storage.push_back(std::make_unique<Entry[]>(first_segment_size << segment));
+        shard.segments[segment].store(shard.segment_storage.back().get(), std::memory_order_release);
+    }
+    return shard.segments[segment].load(std::memory_order_relaxed)[offset];
+}
+
+void StringInterner::grow(Shard& shard) {
+    const Table& old = *shard.tables.back();
+    auto table = std::make_unique<Table>();
+    table->mask = old.mask * 2 + 1;
+    table->slots = std::make_unique<std::atomic<const Entry*>[]>(table->mask + 1);
+    for (std::size_t i = 0; i <= old.mask; i++)
+        if (const Entry* entry = old.slots[i].load(std::memory_order_relaxed))
+            place(*table, entry);
+    shard.table.store(table.get(), std::memory_order_release);
+    shard.tables.push_back(std::move(table));
+}
+
+}  // namespace cless::core::types
@@ -0,0 +1,37 @@
+#ifndef CLESS_FRONT_END_LEXER_CHUNKS_H
+#define CLESS_FRONT_END_LEXER_CHUNKS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "cless/core/parallel/thread_pool.h"
+
+namespace cless::fend::lexer::chunks {
+
+// Splitting of a logical source into pieces that can be lexed independently. A piece starts at the beginning of a
+// line, and with splices removed no token, line comment or literal continues past a newline, so the only state one
+// piece hands to the next is whether it ends inside a block comment.
+
+struct Chunk {
+    const char *begin;
+    const char *end;
+    // whether the chunk starts inside a block comment
+    bool in_comment;
+};
+
+// [begin, end) cut after the first newline at or past every multiple of size; end must follow a newline
+std::vector<Chunk> split(const char *begin, const char *end, std::size_t size);
+
+// after the "*/" that closes a block comment continuing at begin, or end if it is not closed before end
+const char *commentEnd(const char *begin, const char *end);
+
+// whether text that starts inside a block comment or not, as given by in_comment, is inside one at end
+bool endsInComment(const char *begin, const char *end, bool in_comment);
+
+// fills in_comment of every chunk: all chunks are scanned for both start states at once, then the answers are chained
+// from the first chunk, which starts outside of a comment
+void resolveComments(std::vector<Chunk> &chunks, core::parallel::ThreadPool &pool);
+
+}  // namespace cless::fend::lexer::chunks
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CLESS_FRONT_END_LEXER_FLOATING_H
+#define CLESS_FRONT_END_LEXER_FLOATING_H
+
+#include "cless/syntax/token/constant.h"
+
+namespace cless::fend::lexer::floating {
+
+enum class Range {
+    Ok,
+    Overflow,
+    Underflow,
+};
+
+struct Result {
+    long double value;
+    Range range;
+};
+
+// Value of the decimal floating constant spelled in [begin, end), without its suffix, correctly rounded to the type
+// the suffix selects. Out of range constants become infinity or zero.
+Result decode(const char *begin, const char *end, syntax::token::FloatingSuffix suffix);
+
+}  // namespace cless::fend::lexer::floating
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef CLESS_FRONT_END_LEXER_INTEGER_H
+#define CLESS_FRONT_END_LEXER_INTEGER_H
+
+#include <cstdint>
+#include <optional>
+
+#include "cless/front-end/lexer/utils.h"
+#include "cless/syntax/token/constant.h"
+
+namespace cless::fend::lexer::integer {
+
+// Value of the digits in [begin, end), which must all be valid in base, or nullopt if it does not fit in 64 bits.
+// Runs of eight digits are combined at once within a 64-bit word.
+std::optional<std::uint64_t> decode(const char *begin, const char *end, utils::Base base);
+
+// C89 rules for the type of an integer constant, extended with long long: the first type of the list for the suffix
+// and base that can represent value, or nullopt if none can
+std::optional<syntax::token::IntegerType> selectType(
+    std::uint64_t value, syntax::token::IntegerSuffix suffix, utils::Base base);
+
+}  // namespace cless::fend::lexer::integer
+
+#endif
@@ -1,54 +1,191 @@
 #ifndef CLESS_FRONT_END_LEXER_LEXER_H
 #define CLESS_FRONT_END_LEXER_LEXER_H
 
+#include <memory>
+#include <optional>
+#include <string_view>
 #include <vector>
 
-#include "cless/core/types/message.h"
+#include "cless/core/parallel/thread_pool.h"
+#include "cless/core/source/source_manager.h"
+#include "cless/core/types/arena.h"
+#include "cless/core/types/diagnostics.h"
+#include "cless/core/types/string_interner.h"
+#include "cless/front-end/lexer/chunks.h"
+#include "cless/front-end/lexer/spliced_source.h"
+#include "cless/front-end/lexer/utils.h"
 #include "cless/syntax/token/token.h"
+#include "cless/syntax/token/token_buffer.h"
 
 namespace cless::fend::lexer {
 
 class Lexer {
-    std::string path_;
-    std::string source;
+    core::source::SourceManager &sources;
+    core::types::DiagnosticsEngine &diags;
+    core::types::StringInterner &interner;
+    core::source::FileID file;
+    core::source::SourceLocation file_start;
+    // the physical text of file, looked up once instead of through sources for every token
+    std::string_view physical;
+    std::size_t first_line;
+    // shared with the lexers of the chunks of a parallel pass
+    std::shared_ptr<const SplicedSource> spliced;
     const char *ptr;
-    std::size_t line, col;
+    const char *next_splice;
+    std::size_t splice;
+    bool line_column;
+    // fetched when a token first needs its line, so lexing into a TokenBuffer never builds the index
+    mutable const core::source::LineIndex *lines;
+    mutable std::size_t line_hint;
+    bool recovery;
+    // set when a block comment runs to the end of the text
+    bool open_comment;
+    // the "/*" of that comment, unless it was continued from an earlier window
+    std::optional<core::source::SourceLocation> comment_start;
+    bool stream_window;
+    // decoded bodies of literals with escapes, reused from one literal to the next
+    std::string literal_storage;
+    // text of tokens returned as variants that is not in the physical source; lives as long as the lexer
+    core::types::Arena arena;
 
 public:
-    Lexer(std::string path);
+    // LineColumn fills the line and column fields of every token variant from the file's line index, which is built
+    // by the first token that needs it. OffsetOnly leaves them 0: tokens and diagnostics still carry a SourceLocation,
+    // which is resolved only when something prints it.
+    enum class PositionMode {
+        LineColumn,
+        OffsetOnly,
+    };
+
+    // registers the file with sources; sources, diags and interner must outlive the lexer and may be shared with
+    // other lexers
+    Lexer(
+        core::source::SourceManager &sources,
+        core::types::DiagnosticsEngine &diags,
+        core::types::StringInterner &interner,
+        const std::string &path,
+        PositionMode mode = PositionMode::LineColumn);
+    // lexes a file that is already registered with sources
+    Lexer(
+        core::source::SourceManager &sources,
+        core::types::DiagnosticsEngine &diags,
+        core::types::StringInterner &interner,
+        core::source::FileID file,
+        PositionMode mode = PositionMode::LineColumn);
 
+    // what fail() returns after reporting its message, converts to the error result of any Return
+    struct Failure {};
+
+    // messages go to the DiagnosticsEngine, so a result is only the token and whether lexing failed
     template <typename TokenType>
     struct Return {
         std::optional<TokenType> tok;
-        std::vector<core::types::Message> msg;
+        bool error;
+
+        Return(std::optional<TokenType> tok, bool error) : tok(std::move(tok)), error(error) {}
+        Return(Failure) : tok(std::nullopt), error(true) {}
+    };
+
+    // the whole file at once in compact form
+    struct Batch {
+        syntax::token::TokenBuffer tokens;
         bool error;
     };
 
     Return<syntax::token::Token> next();
+    // appends the next token to tokens in compact form and returns its kind
+    Return<syntax::token::TokenKind> next(syntax::token::TokenBuffer &tokens);
+    // lexes everything left in the file; stops at the first error unless error recovery is on
+    Batch tokenizeAll();
+    // Same result as tokenizeAll(), but a large file is cut at newlines into chunks that are lexed on pool. Messages
+    // of the chunks are held back and reported in source order, so diagnostics and the error limit behave as in one
+    // sequential pass. Chunks are at least min_chunk_size bytes; smaller files are lexed in one piece.
+    static constexpr std::size_t default_min_chunk_size = 256 * 1024;
+    Batch tokenizeAll(core::parallel::ThreadPool &pool, std::size_t min_chunk_size = default_min_chunk_size);
+    syntax::token::TokenBuffer tokenBuffer() const;
+
+    // With error recovery a malformed token is reported, skipped and returned as an ErrorToken, so one pass reports
+    // every lexical error. Lexing only stops when the error limit of the DiagnosticsEngine is reached.
+    void setErrorRecovery(bool enable);
+
+    // For text that is one window of a longer stream. A block comment that is still open at the end of the text is not
+    // reported: inComment() tells the window after it, which starts with continueComment(), and openedComment() gives
+    // its "/*" if it was opened in this window, so the caller can report it once the stream ends.
+    void setStreamWindow(bool enable);
+    void continueComment();
+    bool inComment() const;
+    std::optional<core::source::SourceLocation> openedComment() const;
 
     const std::string &path() const;
+    core::source::FileID fileID() const;
 
 private:
+    // a lexer for one chunk of the file of parent that reports to diags
+    Lexer(const Lexer &parent, core::types::DiagnosticsEngine &diags, const chunks::Chunk &chunk);
+
     void adv(std::size_t n = 1);
     char lookForward(std::size_t n = 1) const;
+    void advTo(const char *target);
+    void crossSplices();
 
     struct Position {
         const char *ptr;
-        std::size_t line, col;
+        std::size_t splice;
     };
 
+    Failure fail(core::types::Message msg);
+
     Position tell() const;
-    void seek(const Position &pos);
+    std::string_view spelling(const Position &start) const;
+    // the same bytes in the physical source for text of the logical source without removed splices
+    std::optional<std::string_view> physicalText(std::string_view text) const;
+    // text that stays valid after the lexer is gone
+    std::string_view persist(std::string_view text);
+    std::uint32_t physicalOffset(const char *p) const;
+    core::source::SourceLocation location(const char *p) const;
+    std::pair<std::size_t, std::size_t> lineAndColumn(const char *p) const;
+
+    // a scanned token before it is materialized as a variant or appended to a TokenBuffer
+    struct Lexeme {
+        syntax::token::TokenKind kind;
+        Position start, end;
+        core::types::Symbol symbol;
+        std::uint64_t integer = 0;
+        std::intmax_t character = 0;
+        long double floating = 0;
+        syntax::token::IntegerSuffix integer_suffix = syntax::token::IntegerSuffix::None;
+        syntax::token::IntegerType integer_type = syntax::token::IntegerType::Int;
+        syntax::token::FloatingSuffix floating_suffix = syntax::token::FloatingSuffix::None;
+        std::string_view value;
+
+        Lexeme(syntax::token::TokenKind kind, Position start, Position end) : kind(kind), start(start), end(end) {}
+    };
+
+    template <typename TokenType>
+    TokenType makeToken(Lexeme &&lexeme);
+    void append(syntax::token::TokenBuffer &tokens, Lexeme &&lexeme) const;
 
-    void skipWhitespacesAndComments();
+    // a comment that starts at or after limit is left to the lexer of the text there
+    void skipWhitespacesAndComments(const char *limit);
+    // appends every token that starts before end to tokens; true if lexing stopped at an error
+    bool tokenize(syntax::token::TokenBuffer &tokens, const char *end);
+    Return<Lexeme> scan();
+    // scan() once whitespace and comments are skipped
+    Return<Lexeme> scanSkipped();
+    Return<Lexeme> scanToken();
     Return<syntax::token::PreprocessingToken> nextPreprocessingToken();
     Return<syntax::token::PreprocessingToken> getHeaderName();
-    Return<syntax::token::PreprocessingToken> getIdentifier();
-    Return<syntax::token::PreprocessingToken> getIntegerConstant();
-    Return<syntax::token::PreprocessingToken> getFloatingConstant();
-    Return<syntax::token::PreprocessingToken> getCharacterConstant();
-    Return<syntax::token::PreprocessingToken> getStringLiteral();
-    Return<syntax::token::PreprocessingToken> getPunctuation();
+    Return<Lexeme> getIdentifier();
+    Return<Lexeme> getNumber();
+    Return<Lexeme> getIntegerConstant(
+        const Position &start, const char *digits, const char *suffix_start, utils::Base base);
+    Return<Lexeme> getFloatingConstant(const Position &start, const char *suffix_start);
+    // body of the character constant or string literal at ptr, escapes decoded; a view of the source when there are
+    // none, or of literal_storage otherwise
+    Return<std::string_view> getLiteralBody(const Position &start);
+    Return<Lexeme> getCharacterConstant();
+    Return<Lexeme> getStringLiteral();
+    Return<Lexeme> getPunctuation();
 };
 
 }  // namespace cless::fend::lexer
@@ -0,0 +1,34 @@
+#ifndef CLESS_FRONT_END_LEXER_SPLICED_SOURCE_H
+#define CLESS_FRONT_END_LEXER_SPLICED_SOURCE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "cless/core/source/source_buffer.h"
+
+namespace cless::fend::lexer {
+
+// Logical view of a source buffer after translation phase 2 (line splicing). Buffers without any backslash-newline
+// are used as is; otherwise the spliced text is copied once and the removed splices are kept in a side table so that
+// logical positions can be mapped back to physical lines and offsets.
+class SplicedSource {
+    const core::source::SourceBuffer *physical;
+    core::source::SourceBuffer logical;
+    std::vector<std::size_t> splices;
+
+public:
+    SplicedSource();
+    explicit SplicedSource(const core::source::SourceBuffer &physical);
+
+    const char *data() const;
+    std::size_t size() const;
+    bool hasSplices() const;
+
+    // logical offsets of the first character after each removed backslash-newline, in ascending order
+    const std::vector<std::size_t> &spliceOffsets() const;
+    std::size_t toPhysical(std::size_t offset) const;
+};
+
+}  // namespace cless::fend::lexer
+
+#endif
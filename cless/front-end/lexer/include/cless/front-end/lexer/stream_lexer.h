@@ -0,0 +1,62 @@
+#ifndef CLESS_FRONT_END_LEXER_STREAM_LEXER_H
+#define CLESS_FRONT_END_LEXER_STREAM_LEXER_H
+
+#include <optional>
+#include <string>
+
+#include "cless/core/source/source_manager.h"
+#include "cless/core/source/source_stream.h"
+#include "cless/core/types/diagnostics.h"
+#include "cless/core/types/string_interner.h"
+#include "cless/front-end/lexer/lexer.h"
+
+namespace cless::fend::lexer {
+
+// Lexes a stream such as stdin or a pipe one SourceStream window at a time, so peak memory does not depend on the
+// size of the input. Every window is registered with sources as a file of its own that keeps the stream's path and
+// line numbers, and is released when the next window is read. Windows end at the end of a logical line, so the only
+// state carried from one window to the next is an open block comment. The window with the "/*" of that comment is
+// kept until the comment is closed, so that it can still be reported if the stream ends first.
+class StreamLexer {
+    core::source::SourceManager &sources;
+    core::types::DiagnosticsEngine &diags;
+    core::types::StringInterner &interner;
+    std::string path_;
+    core::source::SourceStream stream;
+    std::optional<core::source::FileID> window;
+    std::optional<core::source::FileID> comment_window;
+    core::source::SourceLocation comment_start;
+    bool in_comment;
+    bool recovery;
+    bool done;
+
+public:
+    // sources, diags and interner must outlive the lexer; the lexer does not close fd
+    StreamLexer(
+        core::source::SourceManager &sources,
+        core::types::DiagnosticsEngine &diags,
+        core::types::StringInterner &interner,
+        int fd,
+        std::string path,
+        std::size_t window_size = core::source::SourceStream::default_window_size);
+    StreamLexer(const StreamLexer &) = delete;
+    StreamLexer &operator=(const StreamLexer &) = delete;
+    ~StreamLexer();
+
+    // The tokens of the next window, which stay valid until the next call. nullopt at the end of the stream or once
+    // a window stopped at an error.
+    std::optional<Lexer::Batch> next();
+
+    // same as Lexer::setErrorRecovery
+    void setErrorRecovery(bool enable);
+
+    const std::string &path() const;
+
+private:
+    void releaseWindow();
+    void releaseCommentWindow();
+};
+
+}  // namespace cless::fend::lexer
+
+#endif
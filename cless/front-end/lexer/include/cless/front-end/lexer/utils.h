@@ -1,6 +1,7 @@
 #ifndef CLESS_FRONT_END_LEXER_UTILS_H
 #define CLESS_FRONT_END_LEXER_UTILS_H
 
+#include <array>
 #include <cctype>
 #include <cstdint>
 #include <optional>
@@ -13,20 +14,86 @@ enum class Base {
     Hexadecimal,
 };
 
+// byte classes of the basic source character set; unlike <cctype> they do not depend on the locale
+enum CharClass : std::uint8_t {
+    IdentifierStart = 1 << 0,
+    Digit = 1 << 1,
+    HexDigit = 1 << 2,
+    OctDigit = 1 << 3,
+    Blank = 1 << 4,
+    Punctuator = 1 << 5,
+};
+
+constexpr std::array<std::uint8_t, 256> char_classes = [] {
+    std::array<std::uint8_t, 256> classes{};
+    for (int c = 'a'; c <= 'z'; c++)
+        classes[c] |= IdentifierStart;
+    for (int c = 'A'; c <= 'Z'; c++)
+        classes[c] |= IdentifierStart;
+    classes['_'] |= IdentifierStart;
+    for (int c = '0'; c <= '9'; c++)
+        classes[c] |= Digit | HexDigit | (c <= '7' ? OctDigit : 0);
+    for (int c = 'a'; c <= 'f'; c++)
+        classes[c] |= HexDigit;
+    for (int c = 'A'; c <= 'F'; c++)
+        classes[c] |= HexDigit;
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+        classes[static_cast<unsigned char>(c)] |= Blank;
+    for (char c : {'[', ']', '(', ')', '{', '}', '.', '-', '+', '&', '*', '~', '!', '/', '%', '<', '>', '^', '|', '?',
+                   ':', ';', '=', ',', '#'})
+        classes[static_cast<unsigned char>(c)] |= Punctuator;
+    return classes;
+}();
+
+constexpr bool hasCharClass(char c, std::uint8_t mask) {
+    return (char_classes[static_cast<unsigned char>(c)] & mask) != 0;
+}
+
 std::intmax_t charToInt(char c);
-bool isEndOfLineChar(char c);
 
-bool isIdentifierChar(char c);
-bool isIdentifierStartChar(char c);
+constexpr bool isEndOfLineChar(char c) {
+    return c == '\n' or c == '\0';
+}
+
+constexpr bool isDigit(char c) {
+    return hasCharClass(c, Digit);
+}
+
+constexpr bool isHexDigit(char c) {
+    return hasCharClass(c, HexDigit);
+}
+
+constexpr bool isIdentifierChar(char c) {
+    return hasCharClass(c, IdentifierStart | Digit);
+}
+
+constexpr bool isIdentifierStartChar(char c) {
+    return hasCharClass(c, IdentifierStart);
+}
+
+constexpr bool isHexBaseChar(char c) {
+    return c == 'x' or c == 'X';
+}
+
+constexpr bool hasBase(char curr, char next, char next_next) {
+    return (curr == '0' and isDigit(next)) or (curr == '0' and isHexBaseChar(next) and isHexDigit(next_next));
+}
+
+constexpr bool isOctDigit(char c) {
+    return hasCharClass(c, OctDigit);
+}
 
-bool isHexBaseChar(char c);
-bool hasBase(char curr, char next, char next_next);
+constexpr bool isExponentChar(char c) {
+    return c == 'e' or c == 'E';
+}
 
-bool isOctDigit(char c);
+constexpr bool isSignChar(char c) {
+    return c == '+' or c == '-';
+}
 
-bool isExponentChar(char c);
-bool isSignChar(char c);
-bool hasExponent(char curr, char next);
+constexpr bool hasExponent(char curr, char next) {
+    return isExponentChar(curr) and (isSignChar(next) or isDigit(next));
+}
 
 bool isSimpleEscapeChar(char c);
 char simpleEscape(char c);
@@ -0,0 +1,82 @@
+#include "cless/front-end/lexer/chunks.h"
+
+#include <cstring>
+#include <utility>
+
+#include "cless/core/source/scan.h"
+
+namespace cless::fend::lexer::chunks {
+namespace scan = core::source::scan;
+
+std::vector<Chunk> split(const char* begin, const char* end, std::size_t size) {
+    std::vector<Chunk> chunks;
+    const char* p = begin;
+    while (p < end) {
+        const char* cut = end;
+        if (static_cast<std::size_t>(end - p) > size) {
+            auto newline = static_cast<const char*>(std::memchr(p + size, '\n', end - (p + size)));
+            if (newline != nullptr)
+                cut = newline + 1;
+        }
+        chunks.push_back({p, cut, false});
+        p = cut;
+    }
+    return chunks;
+}
+
+const char* commentEnd(const char* begin, const char* end) {
+    // the same scan as the lexer's; past end it only runs to the next "*/" or '\0', which the padding guarantees
+    const char* p = scan::findCommentEnd(begin, end);
+    return p < end ? p + 2 : end;
+}
+
+bool endsInComment(const char* begin, const char* end, bool in_comment) {
+    // the same decisions skipWhitespacesAndComments() and the literal scanners make, without building tokens
+    const char* p = begin;
+    if (in_comment) {
+        // a chunk ends with a newline, so a closed comment never ends at end
+        p = commentEnd(p, end);
+        if (p == end)
+            return true;
+    }
+    while (p < end) {
+        if (*p == '/' and *(p + 1) == '/') {
+            p = scan::findLineEnd(p + 2, end) + 1;
+        } else if (*p == '/' and *(p + 1) == '*') {
+            p = commentEnd(p + 2, end);
+            if (p == end)
+                return true;
+        } else if (*p == '"' or *p == '\'') {
+            // a backslash takes the next character along, and a literal without its closing quote ends at the newline
+            const char quote = *p++;
+            while (true) {
+                p = scan::findLiteralEnd(p, quote);
+                if (*p == '\\' and *(p + 1) != '\n' and *(p + 1) != '\0') {
+                    p += 2;
+                    continue;
+                }
+                if (*p == quote)
+                    p++;
+                break;
+            }
+        } else {
+            p++;
+        }
+    }
+    return false;
+}
+
+void resolveComments(std::vector<Chunk>& chunks, core::parallel::ThreadPool& pool) {
+    std::vector<std::pair<bool, bool>> ends(chunks.size());
+    pool.parallelFor(chunks.size(), [&](std::size_t i) {
+        ends[i] = {endsInComment(chunks[i].begin, chunks[i].end, false),
+                   endsInComment(chunks[i].begin, chunks[i].end, true)};
+    });
+    bool in_comment = false;
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        chunks[i].in_comment = in_comment;
+        in_comment = in_comment ? ends[i].second : ends[i].first;
+    }
+}
+
+}  // namespace cless::fend::lexer::chunks
@@ -0,0 +1,132 @@
+#include "cless/front-end/lexer/floating.h"
+
+#include <locale.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "cless/front-end/lexer/utils.h"
+
+namespace cless::fend::lexer::floating {
+
+using syntax::token::FloatingSuffix;
+
+// the first 19 significant digits, which always fit in 64 bits, and the power of ten they are scaled by
+struct Decimal {
+    std::uint64_t mantissa;
+    std::int64_t exponent;
+    std::int64_t digits;
+    bool truncated;
+};
+
+static Decimal scan(const char* p, const char* end) {
+    Decimal decimal{0, 0, 0, false};
+    auto take = [&](char c, bool fraction) {
+        if (decimal.mantissa == 0 and c == '0') {
+            decimal.exponent -= fraction;
+        } else if (decimal.digits < 19) {
+            decimal.mantissa = decimal.mantissa * 10 + (c - '0');
+            decimal.digits++;
+            decimal.exponent -= fraction;
+        } else {
+            decimal.truncated |= c != '0';
+            decimal.exponent += not fraction;
+        }
+    };
+    for (; p < end and utils::isDigit(*p); p++)
+        take(*p, false);
+    if (p < end and *p == '.')
+        for (p++; p < end and utils::isDigit(*p); p++)
+            take(*p, true);
+    if (p < end and utils::isExponentChar(*p)) {
+        p++;
+        bool negative = *p == '-';
+        if (utils::isSignChar(*p))
+            p++;
+        // anything past this is out of range for every type anyway
+        std::int64_t exponent = 0;
+        for (; p < end and utils::isDigit(*p); p++)
+            exponent = std::min<std::int64_t>(exponent * 10 + (*p - '0'), 1 << 20);
+        decimal.exponent += negative ? -exponent : exponent;
+    }
+    return decimal;
+}
+
+// largest power of ten that is exact in T: 10^e = 2^e * 5^e, so 5^e has to fit in the significand
+template <typename T>
+constexpr int max_exact_power = [] {
+    __extension__ using uint128 = unsigned __int128;
+    auto limit = uint128(1) << std::numeric_limits<T>::digits;
+    int e = 0;
+    for (uint128 five = 5; five <= limit; five *= 5)
+        e++;
+    return e;
+}();
+
+template <typename T>
+static T exactPowerOfTen(int e) {
+    static constexpr auto powers = [] {
+        std::array<T, max_exact_power<T> + 1> powers{};
+        T power = 1;
+        for (auto& p : powers) {
+            p = power;
+            power *= 10;
+        }
+        return powers;
+    }();
+    return powers[e];
+}
+
+template <typename T>
+static Result convert(const char* begin, const char* end, const Decimal& decimal) {
+    if (decimal.mantissa == 0)
+        return {0, Range::Ok};
+
+    // Clinger's fast path: an exact significand times an exact power of ten needs only one rounding
+    constexpr int digits = std::numeric_limits<T>::digits;
+    constexpr auto max_mantissa = digits < 64 ? std::uint64_t(1) << digits : std::numeric_limits<std::uint64_t>::max();
+    if (not decimal.truncated and decimal.mantissa <= max_mantissa and decimal.exponent >= -max_exact_power<T> and
+        decimal.exponent <= max_exact_power<T>) {
+        T value = static_cast<T>(decimal.mantissa);
+        if (decimal.exponent < 0)
+            value /= exactPowerOfTen<T>(static_cast<int>(-decimal.exponent));
+        else
+            value *= exactPowerOfTen<T>(static_cast<int>(decimal.exponent));
+        return {value, Range::Ok};
+    }
+
+    T value;
+    if constexpr (std::is_same_v<T, long double>) {
+        // libstdc++ rejects subnormal long doubles in from_chars; the spelling ends at a character that cannot
+        // continue the number, so strtold stops exactly at end
+        static locale_t c_locale = newlocale(LC_ALL_MASK, "C", nullptr);
+        value = strtold_l(begin, nullptr, c_locale);
+    } else if (std::from_chars(begin, end, value, std::chars_format::general).ec == std::errc::result_out_of_range) {
+        value = decimal.digits + decimal.exponent > 0 ? std::numeric_limits<T>::infinity() : 0;
+    }
+    if (value == std::numeric_limits<T>::infinity())
+        return {value, Range::Overflow};
+    if (value == 0)
+        return {0, Range::Underflow};
+    return {value, Range::Ok};
+}
+
+Result decode(const char* begin, const char* end, FloatingSuffix suffix) {
+    auto decimal = scan(begin, end);
+    switch (suffix) {
+        case FloatingSuffix::Float:
+            return convert<float>(begin, end, decimal);
+        case FloatingSuffix::LongDouble:
+            return convert<long double>(begin, end, decimal);
+        case FloatingSuffix::None:
+            break;
+    }
+    return convert<double>(begin, end, decimal);
+}
+
+}  // namespace cless::fend::lexer::floating
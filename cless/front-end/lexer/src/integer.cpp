@@ -0,0 +1,130 @@
+#include "cless/front-end/lexer/integer.h"
+
+#include <climits>
+#include <cstring>
+#include <span>
+
+namespace cless::fend::lexer::integer {
+
+using syntax::token::IntegerSuffix;
+using syntax::token::IntegerType;
+
+static std::uint64_t load(const char* p) {
+    std::uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    if constexpr (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        word = __builtin_bswap64(word);
+    return word;
+}
+
+// Eight digit values, one per byte with the most significant digit in the lowest byte, combined into one number.
+// Adjacent bytes are merged into pairs first; the four pairs are then weighted with two multiplications whose
+// interesting part lands in the upper half of the word.
+template <std::uint64_t radix>
+static std::uint64_t combine(std::uint64_t digits) {
+    constexpr std::uint64_t r2 = radix * radix, r4 = r2 * r2, r6 = r4 * r2;
+    constexpr std::uint64_t mask = 0x000000FF000000FF;
+    digits = digits * radix + (digits >> 8);
+    return ((digits & mask) * (r2 + (r6 << 32)) + ((digits >> 16) & mask) * (1 + (r4 << 32))) >> 32;
+}
+
+static std::uint64_t eightDigits(const char* p, utils::Base base) {
+    std::uint64_t word = load(p);
+    switch (base) {
+        case utils::Base::Octal:
+            return combine<8>(word - 0x3030303030303030);
+        case utils::Base::Decimal:
+            return combine<10>(word - 0x3030303030303030);
+        case utils::Base::Hexadecimal:
+            // the low nibble of '0'-'9' is the digit; letters have bit 6 set and are 9 short
+            return combine<16>((word & 0x0F0F0F0F0F0F0F0F) + ((word >> 6) & 0x0101010101010101) * 9);
+    }
+    return 0;
+}
+
+static std::uint64_t radixOf(utils::Base base) {
+    switch (base) {
+        case utils::Base::Octal:
+            return 8;
+        case utils::Base::Decimal:
+            return 10;
+        case utils::Base::Hexadecimal:
+            return 16;
+    }
+    return 10;
+}
+
+std::optional<std::uint64_t> decode(const char* begin, const char* end, utils::Base base) {
+    std::uint64_t radix = radixOf(base);
+    std::uint64_t radix8 = radix * radix * radix * radix;
+    radix8 *= radix8;
+
+    std::uint64_t value = 0;
+    const char* p = begin;
+    for (; end - p >= 8; p += 8)
+        if (__builtin_mul_overflow(value, radix8, &value) or
+            __builtin_add_overflow(value, eightDigits(p, base), &value))
+            return std::nullopt;
+    for (; p < end; p++)
+        if (__builtin_mul_overflow(value, radix, &value) or
+            __builtin_add_overflow(value, static_cast<std::uint64_t>(utils::charToInt(*p)), &value))
+            return std::nullopt;
+    return value;
+}
+
+static std::uint64_t maxOf(IntegerType type) {
+    switch (type) {
+        case IntegerType::Int:
+            return INT_MAX;
+        case IntegerType::UnsignedInt:
+            return UINT_MAX;
+        case IntegerType::Long:
+            return LONG_MAX;
+        case IntegerType::UnsignedLong:
+            return ULONG_MAX;
+        case IntegerType::LongLong:
+            return LLONG_MAX;
+        case IntegerType::UnsignedLongLong:
+            return ULLONG_MAX;
+    }
+    return 0;
+}
+
+// C89 lists for each suffix, each followed by the long long types
+static std::span<const IntegerType> candidates(IntegerSuffix suffix, utils::Base base) {
+    using enum IntegerType;
+    static constexpr IntegerType decimal[] = {Int, Long, UnsignedLong, LongLong, UnsignedLongLong};
+    static constexpr IntegerType non_decimal[] = {Int, UnsignedInt, Long, UnsignedLong, LongLong, UnsignedLongLong};
+    static constexpr IntegerType unsigned_int[] = {UnsignedInt, UnsignedLong, UnsignedLongLong};
+    static constexpr IntegerType long_int[] = {Long, UnsignedLong, LongLong, UnsignedLongLong};
+    static constexpr IntegerType unsigned_long[] = {UnsignedLong, UnsignedLongLong};
+    static constexpr IntegerType long_long[] = {LongLong, UnsignedLongLong};
+    static constexpr IntegerType unsigned_long_long[] = {UnsignedLongLong};
+    switch (suffix) {
+        case IntegerSuffix::None:
+            // an unsuffixed decimal constant never becomes unsigned int
+            if (base == utils::Base::Decimal)
+                return decimal;
+            return non_decimal;
+        case IntegerSuffix::Unsigned:
+            return unsigned_int;
+        case IntegerSuffix::Long:
+            return long_int;
+        case IntegerSuffix::UnsignedLong:
+            return unsigned_long;
+        case IntegerSuffix::LongLong:
+            return long_long;
+        case IntegerSuffix::UnsignedLongLong:
+            return unsigned_long_long;
+    }
+    return {};
+}
+
+std::optional<IntegerType> selectType(std::uint64_t value, IntegerSuffix suffix, utils::Base base) {
+    for (auto type : candidates(suffix, base))
+        if (value <= maxOf(type))
+            return type;
+    return std::nullopt;
+}
+
+}  // namespace cless::fend::lexer::integer
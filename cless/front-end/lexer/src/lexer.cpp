@@ -1,141 +1,540 @@
 #include "cless/front-end/lexer/lexer.h"
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <functional>
 #include <limits>
 
+#include "cless/core/instrument/instrument.h"
 #include "cless/core/print/ansi_escape.h"
+#include "cless/core/source/scan.h"
 #include "cless/core/types/exception.h"
+#include "cless/front-end/lexer/floating.h"
+#include "cless/front-end/lexer/integer.h"
 #include "cless/front-end/lexer/utils.h"
 
 namespace cless::fend::lexer {
+namespace scan = core::source::scan;
 using core::types::Message;
 using syntax::token::PreprocessingToken;
 using syntax::token::Token;
+using syntax::token::TokenBuffer;
+using syntax::token::TokenKind;
 
-Lexer::Lexer(std::string path) : path_(std::move(path)) {
-    std::ifstream file(path_);
-    if (not file.is_open()) {
+static core::source::FileID loadOrExit(core::source::SourceManager& sources, const std::string& path) {
+    // "-" reads the translation unit from stdin
+    auto loaded = sources.loadFile(path);
+    if (not loaded.has_value()) {
         std::cerr << core::print::Bold << "cless: " << core::print::Red << "error:" << core::print::Reset
-                  << " cannot find " << path_ << ": no such file" << std::endl;
+                  << " cannot open " << path << ": " << std::strerror(loaded.error()) << std::endl;
         std::exit(EXIT_FAILURE);
     }
+    return loaded.value();
+}
+
+Lexer::Lexer(
+    core::source::SourceManager& sources,
+    core::types::DiagnosticsEngine& diags,
+    core::types::StringInterner& interner,
+    const std::string& path,
+    PositionMode mode)
+    : Lexer(sources, diags, interner, loadOrExit(sources, path), mode) {}
+
+Lexer::Lexer(
+    core::source::SourceManager& sources,
+    core::types::DiagnosticsEngine& diags,
+    core::types::StringInterner& interner,
+    core::source::FileID file,
+    PositionMode mode)
+    : sources(sources),
+      diags(diags),
+      interner(interner),
+      file(file),
+      file_start(sources.startOf(file)),
+      physical(sources.buffer(file).view()),
+      first_line(sources.firstLine(file)),
+      line_column(mode == PositionMode::LineColumn),
+      lines(nullptr),
+      line_hint(1),
+      recovery(false),
+      open_comment(false),
+      stream_window(false) {
+    {
+        core::instrument::Timer timer("splice lines", sources.path(file));
+        spliced = std::make_shared<const SplicedSource>(sources.buffer(file));
+    }
+    ptr = spliced->data();
+    splice = 0;
+    crossSplices();
+}
 
-    source = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-    if (source.back() != '\n')
-        source.push_back('\n');
-    ptr = &source[0];
-    line = 1;
-    col = 1;
+Lexer::Lexer(const Lexer& parent, core::types::DiagnosticsEngine& diags, const chunks::Chunk& chunk)
+    : sources(parent.sources),
+      diags(diags),
+      interner(parent.interner),
+      file(parent.file),
+      file_start(parent.file_start),
+      physical(parent.physical),
+      first_line(parent.first_line),
+      spliced(parent.spliced),
+      ptr(chunk.begin),
+      line_column(parent.line_column),
+      lines(parent.lines),
+      line_hint(1),
+      recovery(parent.recovery),
+      open_comment(false),
+      stream_window(parent.stream_window) {
+    const auto& offsets = spliced->spliceOffsets();
+    splice = std::lower_bound(offsets.begin(), offsets.end(), static_cast<std::size_t>(ptr - spliced->data())) -
+             offsets.begin();
+    crossSplices();
+    if (chunk.in_comment)
+        advTo(chunks::commentEnd(ptr, chunk.end));
 }
 
 Lexer::Return<Token> Lexer::next() {
-    auto pp_token = nextPreprocessingToken();
-    if (pp_token.error)
-        return {std::nullopt, std::move(pp_token.msg), true};
-    if (pp_token.tok.has_value())
-        return {syntax::token::toToken(pp_token.tok.value()), pp_token.msg, false};
-    return {std::nullopt, pp_token.msg, false};
+    auto lexeme = scan();
+    if (lexeme.error)
+        return {std::nullopt, true};
+    if (lexeme.tok.has_value())
+        return {makeToken<Token>(std::move(lexeme.tok.value())), false};
+    return {std::nullopt, false};
+}
+
+Lexer::Return<TokenKind> Lexer::next(TokenBuffer& tokens) {
+    auto lexeme = scan();
+    if (lexeme.error)
+        return {std::nullopt, true};
+    if (lexeme.tok.has_value()) {
+        auto kind = lexeme.tok->kind;
+        append(tokens, std::move(lexeme.tok.value()));
+        return {kind, false};
+    }
+    return {std::nullopt, false};
+}
+
+// C averages around six source bytes per token once whitespace and comments are counted, so this reserves about
+// enough for one pass without regrowing
+static std::size_t expectedTokens(std::size_t bytes) {
+    return bytes / 6 + 1;
+}
+
+Lexer::Batch Lexer::tokenizeAll() {
+    core::instrument::Timer timer("lex", path());
+    Batch batch{tokenBuffer(), false};
+    const char* end = spliced->data() + spliced->size();
+    core::instrument::count("bytes lexed", end - ptr);
+    batch.tokens.reserve(expectedTokens(end - ptr));
+    batch.error = tokenize(batch.tokens, end);
+    core::instrument::count("tokens", batch.tokens.size());
+    return batch;
+}
+
+Lexer::Batch Lexer::tokenizeAll(core::parallel::ThreadPool& pool, std::size_t min_chunk_size) {
+    // by default chunks are large enough that setting up a lexer for each is noise, and there are a few per thread so
+    // that a slow chunk does not hold up the others
+    constexpr std::size_t chunks_per_thread = 4;
+    const char* end = spliced->data() + spliced->size();
+    auto chunk_size = std::max(min_chunk_size, static_cast<std::size_t>(end - ptr) / (pool.size() * chunks_per_thread));
+    if (static_cast<std::size_t>(end - ptr) < 2 * chunk_size)
+        return tokenizeAll();
+
+    core::instrument::Timer timer("lex", path());
+    core::instrument::count("bytes lexed", end - ptr);
+    auto pieces = chunks::split(ptr, end, chunk_size);
+    {
+        core::instrument::Timer timer("find comments", path());
+        chunks::resolveComments(pieces, pool);
+    }
+
+    struct ChunkResult {
+        TokenBuffer tokens;
+        // every message with the number of tokens the chunk had when it was reported
+        std::vector<std::pair<Message, std::size_t>> messages;
+        bool error;
+    };
+    std::vector<ChunkResult> results;
+    results.reserve(pieces.size());
+    for (std::size_t i = 0; i < pieces.size(); i++)
+        results.push_back({tokenBuffer(), {}, false});
+    pool.parallelFor(pieces.size(), [&](std::size_t i) {
+        core::instrument::Timer timer("lex chunk", path());
+        auto& result = results[i];
+        core::types::DiagnosticsEngine chunk_diags(
+            [&result](const Message& msg) { result.messages.emplace_back(msg, result.tokens.size()); });
+        Lexer lexer(*this, chunk_diags, pieces[i]);
+        result.tokens.reserve(expectedTokens(pieces[i].end - pieces[i].begin));
+        result.error = lexer.tokenize(result.tokens, pieces[i].end);
+    });
+
+    // a sequential pass stops at the token whose message reaches the error limit, and so does the stitched batch
+    core::instrument::Timer stitch("stitch chunks", path());
+    Batch batch{tokenBuffer(), false};
+    for (auto& result : results) {
+        for (auto& [msg, count] : result.messages) {
+            diags.report(std::move(msg));
+            if (diags.limitReached()) {
+                result.tokens.truncate(count);
+                result.error = true;
+                break;
+            }
+        }
+        batch.tokens.append(std::move(result.tokens));
+        if (result.error) {
+            batch.error = true;
+            break;
+        }
+    }
+    advTo(end);
+    core::instrument::count("tokens", batch.tokens.size());
+    return batch;
+}
+
+TokenBuffer Lexer::tokenBuffer() const {
+    return {sources, file};
+}
+
+void Lexer::setErrorRecovery(bool enable) {
+    recovery = enable;
+}
+
+void Lexer::setStreamWindow(bool enable) {
+    stream_window = enable;
+}
+
+void Lexer::continueComment() {
+    const char* end = spliced->data() + spliced->size();
+    const char* p = scan::findCommentEnd(ptr, end);
+    if (p != end)
+        p += 2;
+    else
+        open_comment = true;
+    advTo(p);
+}
+
+bool Lexer::inComment() const {
+    return open_comment;
+}
+
+std::optional<core::source::SourceLocation> Lexer::openedComment() const {
+    return comment_start;
 }
 
 const std::string& Lexer::path() const {
-    return path_;
+    return sources.path(file);
+}
+
+core::source::FileID Lexer::fileID() const {
+    return file;
 }
 
 void Lexer::adv(std::size_t n) {
     for (std::size_t i = 0; i < n; i++) {
-        if (*ptr == '\0')
+        // a '\0' inside the text is a stray character like any other, only the terminator stops
+        if (*ptr == '\0' and ptr == spliced->data() + spliced->size())
             break;
-        if (*ptr == '\n') {
-            line++;
-            col = 0;
-        }
-        if (*(ptr + 1) == '\\' and *(ptr + 2) == '\n') {
-            ptr += 2;
-            line++;
-            col = 0;
-        }
         ptr++;
-        col++;
+        if (ptr == next_splice)
+            crossSplices();
     }
 }
 
 char Lexer::lookForward(std::size_t n) const {
-    const char* p = ptr;
-    for (std::size_t i = 0; i < n; i++) {
-        if (*(p + 1) == '\0')
-            return '\0';
-        if (*(p + 1) == '\\' and *(p + 2) == '\n')
-            p += 2;
-        p++;
+    // splices are already removed and the buffer is zero padded, so lookahead is plain indexing
+    return ptr[n];
+}
+
+void Lexer::crossSplices() {
+    const auto& offsets = spliced->spliceOffsets();
+    const char* begin = spliced->data();
+    while (splice < offsets.size() and begin + offsets[splice] == ptr)
+        splice++;
+    next_splice = splice < offsets.size() ? begin + offsets[splice] : nullptr;
+}
+
+void Lexer::advTo(const char* target) {
+    // bulk version of adv() for runs without token boundaries
+    while (next_splice != nullptr and next_splice <= target) {
+        splice++;
+        const auto& offsets = spliced->spliceOffsets();
+        next_splice = splice < offsets.size() ? spliced->data() + offsets[splice] : nullptr;
     }
-    return *p;
+    ptr = target;
 }
 
-Lexer::Position Lexer::tell() const {
-    return {ptr, line, col};
+std::string_view Lexer::spelling(const Position& start) const {
+    return {start.ptr, static_cast<std::size_t>(ptr - start.ptr)};
+}
+
+std::optional<std::string_view> Lexer::physicalText(std::string_view text) const {
+    std::less<const char*> before;
+    if (before(text.data(), spliced->data()) or before(spliced->data() + spliced->size(), text.data() + text.size()))
+        return std::nullopt;
+    auto begin = physicalOffset(text.data());
+    if (physicalOffset(text.data() + text.size()) - begin != text.size())
+        return std::nullopt;
+    return physical.substr(begin, text.size());
+}
+
+std::string_view Lexer::persist(std::string_view text) {
+    if (auto physical = physicalText(text); physical.has_value())
+        return physical.value();
+    return arena.copy(text);
+}
+
+std::uint32_t Lexer::physicalOffset(const char* p) const {
+    return static_cast<std::uint32_t>(spliced->toPhysical(p - spliced->data()));
+}
+
+core::source::SourceLocation Lexer::location(const char* p) const {
+    return file_start.withOffset(physicalOffset(p));
+}
+
+std::pair<std::size_t, std::size_t> Lexer::lineAndColumn(const char* p) const {
+    if (not line_column)
+        return {0, 0};
+    if (lines == nullptr)
+        lines = &sources.lineIndex(file);
+    auto offset = physicalOffset(p);
+    line_hint = lines->lineOf(offset, line_hint);
+    return {first_line + line_hint - 1, lines->columnOf(offset, line_hint)};
 }
 
-void Lexer::seek(const Position& pos) {
-    ptr = pos.ptr;
-    line = pos.line;
-    col = pos.col;
+Lexer::Failure Lexer::fail(Message msg) {
+    diags.report(std::move(msg));
+    return {};
 }
 
-void Lexer::skipWhitespacesAndComments() {
+Lexer::Position Lexer::tell() const {
+    return {ptr, splice};
+}
+
+void Lexer::skipWhitespacesAndComments(const char* limit) {
     // skip whitespaces and comments
+    const char* end = spliced->data() + spliced->size();
     while (true) {
-        if (std::isspace(*ptr)) {
-            adv();
-        } else if (*ptr == '/' and lookForward() == '/') {
-            adv(2);
-            while (not utils::isEndOfLineChar(*ptr))
-                adv();
-            adv();
-        } else if (*ptr == '/' and lookForward() == '*') {
-            adv(2);
-            while (*ptr != '*' or lookForward() != '/')
-                adv();
-            adv(2);
+        const char* p = scan::skipBlanks(ptr);
+        if (p >= limit) {
+            advTo(p);
+            break;
+        }
+        if (*p == '/' and *(p + 1) == '/') {
+            p = scan::findLineEnd(p + 2, end);
+            if (*p == '\n')
+                p++;
+        } else if (*p == '/' and *(p + 1) == '*') {
+            const char* opening = p;
+            p = scan::findCommentEnd(p + 2, end);
+            if (p != end) {
+                p += 2;
+            } else {
+                open_comment = true;
+                comment_start = location(opening);
+                if (not stream_window)
+                    diags.report(Message::error(comment_start.value(), "unterminated /* comment"));
+            }
         } else {
+            advTo(p);
             break;
         }
+        advTo(p);
     }
 }
 
+// the first byte of a preprocessing token selects the only scanner that can match it
+enum class TokenStart : std::uint8_t {
+    None,
+    Identifier,
+    Number,
+    Dot,
+    CharacterConstant,
+    StringLiteral,
+    Punctuation,
+};
+
+static constexpr std::array<TokenStart, 256> token_starts = [] {
+    std::array<TokenStart, 256> starts{};
+    for (int c = 0; c < 256; c++) {
+        if (utils::isIdentifierStartChar(static_cast<char>(c)))
+            starts[c] = TokenStart::Identifier;
+        else if (utils::isDigit(static_cast<char>(c)))
+            starts[c] = TokenStart::Number;
+        else if (utils::hasCharClass(static_cast<char>(c), utils::Punctuator))
+            starts[c] = TokenStart::Punctuation;
+    }
+    starts['.'] = TokenStart::Dot;
+    starts['\''] = TokenStart::CharacterConstant;
+    starts['"'] = TokenStart::StringLiteral;
+    return starts;
+}();
+
 Lexer::Return<PreprocessingToken> Lexer::nextPreprocessingToken() {
-    skipWhitespacesAndComments();
+    auto lexeme = scan();
+    if (lexeme.error)
+        return {std::nullopt, true};
+    if (lexeme.tok.has_value())
+        return {makeToken<PreprocessingToken>(std::move(lexeme.tok.value())), false};
+    return {std::nullopt, false};
+}
 
-    if (auto ident = getIdentifier(); ident.tok.has_value() or ident.error) {
-        if (ident.error)
-            return {std::nullopt, std::move(ident.msg), true};
-        return {ident.tok.value(), std::move(ident.msg), false};
-    }
-    if (auto punct = getPunctuation(); punct.tok.has_value() or punct.error) {
-        if (punct.error)
-            return {std::nullopt, std::move(punct.msg), true};
-        return {punct.tok.value(), std::move(punct.msg), false};
+template <typename TokenType>
+TokenType Lexer::makeToken(Lexeme&& lexeme) {
+    auto kind = lexeme.kind;
+    const auto& start = lexeme.start;
+    const auto& end = lexeme.end;
+    auto loc = location(start.ptr);
+    auto [line_start, col_start] = lineAndColumn(start.ptr);
+    auto [line_end, col_end] = lineAndColumn(end.ptr);
+    auto text = persist(std::string_view(start.ptr, end.ptr - start.ptr));
+    switch (kind) {
+        case TokenKind::Identifier:
+            return syntax::token::Identifier(
+                interner.spelling(lexeme.symbol), lexeme.symbol, loc, line_start, line_end, col_start, col_end);
+        case TokenKind::IntegerConstant:
+            return syntax::token::IntegerConstant(
+                lexeme.integer,
+                lexeme.integer_suffix,
+                lexeme.integer_type,
+                text,
+                loc,
+                line_start,
+                line_end,
+                col_start,
+                col_end);
+        case TokenKind::FloatingConstant:
+            return syntax::token::FloatingConstant(
+                lexeme.floating,
+                lexeme.floating_suffix,
+                text,
+                loc,
+                line_start,
+                line_end,
+                col_start,
+                col_end);
+        case TokenKind::CharacterConstant:
+            return syntax::token::CharacterConstant(
+                lexeme.character,
+                text.substr(1, text.size() - 2),
+                loc,
+                line_start,
+                line_end,
+                col_start,
+                col_end);
+        case TokenKind::Error:
+            return syntax::token::ErrorToken(text, loc, line_start, line_end, col_start, col_end);
+        case TokenKind::StringLiteral:
+            return syntax::token::StringLiteral(
+                persist(lexeme.value),
+                text.substr(1, text.size() - 2),
+                loc,
+                line_start,
+                line_end,
+                col_start,
+                col_end);
+        default:
+            break;
     }
-    if (auto float_const = getFloatingConstant(); float_const.tok.has_value() or float_const.error) {
-        if (float_const.error)
-            return {std::nullopt, std::move(float_const.msg), true};
-        return {float_const.tok.value(), std::move(float_const.msg), false};
+    if constexpr (std::is_same_v<TokenType, Token>) {
+        return syntax::token::buildToken(kind, loc, line_start, line_end, col_start, col_end);
+    } else {
+        // keywords are ordinary identifiers until translation phase 7
+        if (syntax::token::isKeyword(kind))
+            return syntax::token::Identifier(
+                text, interner.intern(text), loc, line_start, line_end, col_start, col_end);
+        auto type = static_cast<syntax::token::PunctuationType>(
+            static_cast<std::size_t>(kind) - syntax::token::keyword_kind_count);
+        return syntax::token::buildPunctuation(type, loc, line_start, line_end, col_start, col_end);
     }
-    if (auto int_const = getIntegerConstant(); int_const.tok.has_value() or int_const.error) {
-        if (int_const.error)
-            return {std::nullopt, std::move(int_const.msg), true};
-        return {int_const.tok.value(), std::move(int_const.msg), false};
+}
+
+void Lexer::append(TokenBuffer& tokens, Lexeme&& lexeme) const {
+    auto offset = physicalOffset(lexeme.start.ptr);
+    auto length = physicalOffset(lexeme.end.ptr) - offset;
+    switch (lexeme.kind) {
+        case TokenKind::Identifier:
+            tokens.pushIdentifier(offset, length, lexeme.symbol);
+            break;
+        case TokenKind::IntegerConstant:
+            tokens.pushInteger(offset, length, {lexeme.integer, lexeme.integer_suffix, lexeme.integer_type});
+            break;
+        case TokenKind::FloatingConstant:
+            tokens.pushFloating(offset, length, {lexeme.floating, lexeme.floating_suffix});
+            break;
+        case TokenKind::CharacterConstant:
+            tokens.pushCharacter(offset, length, lexeme.character);
+            break;
+        case TokenKind::StringLiteral:
+            tokens.pushString(offset, length, physicalText(lexeme.value).value_or(lexeme.value));
+            break;
+        default:
+            tokens.push(lexeme.kind, offset, length);
+            break;
     }
-    if (auto char_const = getCharacterConstant(); char_const.tok.has_value() or char_const.error) {
-        if (char_const.error)
-            return {std::nullopt, std::move(char_const.msg), true};
-        return {char_const.tok.value(), std::move(char_const.msg), false};
+    // the physical spelling is longer when a splice was removed inside the token
+    if (length != static_cast<std::uint32_t>(lexeme.end.ptr - lexeme.start.ptr))
+        tokens.setUnspliced(std::string_view(lexeme.start.ptr, lexeme.end.ptr - lexeme.start.ptr));
+}
+
+bool Lexer::tokenize(TokenBuffer& tokens, const char* end) {
+    while (true) {
+        // whitespace is skipped first, so a chunk never scans the token or opens the comment that starts the next one;
+        // a comment it did open is skipped to its end, also when that is in a later chunk
+        skipWhitespacesAndComments(end);
+        if (ptr >= end)
+            return false;
+        auto lexeme = scanSkipped();
+        if (lexeme.error or diags.limitReached())
+            return true;
+        if (not lexeme.tok.has_value())
+            return false;
+        append(tokens, std::move(lexeme.tok.value()));
     }
-    if (auto str_lit = getStringLiteral(); str_lit.tok.has_value() or str_lit.error) {
-        if (str_lit.error)
-            return {std::nullopt, std::move(str_lit.msg), true};
-        return {str_lit.tok.value(), std::move(str_lit.msg), false};
+}
+
+Lexer::Return<Lexer::Lexeme> Lexer::scan() {
+    skipWhitespacesAndComments(spliced->data() + spliced->size());
+    return scanSkipped();
+}
+
+Lexer::Return<Lexer::Lexeme> Lexer::scanSkipped() {
+    auto start = tell();
+    auto lexeme = scanToken();
+    if (not lexeme.error or not recovery or diags.limitReached())
+        return lexeme;
+    // every failure leaves ptr after the malformed token; the check only guards against a stuck lexer
+    if (ptr == start.ptr)
+        adv();
+    return {Lexeme(TokenKind::Error, start, tell()), false};
+}
+
+Lexer::Return<Lexer::Lexeme> Lexer::scanToken() {
+    switch (token_starts[static_cast<unsigned char>(*ptr)]) {
+        case TokenStart::Identifier:
+            return getIdentifier();
+        case TokenStart::Number:
+            return getNumber();
+        case TokenStart::Dot:
+            if (utils::isDigit(lookForward()))
+                return getNumber();
+            return getPunctuation();
+        case TokenStart::CharacterConstant:
+            return getCharacterConstant();
+        case TokenStart::StringLiteral:
+            return getStringLiteral();
+        case TokenStart::Punctuation:
+            return getPunctuation();
+        case TokenStart::None:
+            break;
     }
-    return {std::nullopt, {}, false};
+    if (ptr == spliced->data() + spliced->size())
+        return {std::nullopt, false};
+    const char* stray = ptr;
+    adv();
+    if (std::isprint(static_cast<unsigned char>(*stray)))
+        return fail(Message::error(location(stray), std::string("stray '") + *stray + "' in program"));
+    return fail(Message::error(location(stray), "stray character in program"));
 }
 
 Lexer::Return<PreprocessingToken> Lexer::getHeaderName() {
@@ -145,502 +544,278 @@ Lexer::Return<PreprocessingToken> Lexer::getHeaderName() {
         adv();
         while (*ptr != '>') {
             if (utils::isEndOfLineChar(*ptr))
-                return {
-                    std::nullopt,
-                    {Message::error(path_, start.line, start.col, "missing closing angle bracket")},
-                    true};
+                return fail(Message::error(location(start.ptr), "missing closing angle bracket"));
             name.push_back(*ptr);
             adv();
         }
         adv();
-        auto end = tell();
-        return {syntax::token::HeaderName(name, true, path_, start.line, end.line, start.col, end.col), {}, false};
+        auto [line_start, col_start] = lineAndColumn(start.ptr);
+        auto [line_end, col_end] = lineAndColumn(ptr);
+        return {
+            syntax::token::HeaderName(name, true, location(start.ptr), line_start, line_end, col_start, col_end),
+            false};
     } else if (*ptr == '"') {
         std::string name;
         adv();
         while (*ptr != '"') {
             if (utils::isEndOfLineChar(*ptr))
-                return {
-                    std::nullopt, {Message::error(path_, start.line, start.col, "missing closing double quote")}, true};
+                return fail(Message::error(location(start.ptr), "missing closing double quote"));
             name.push_back(*ptr);
             adv();
         }
         adv();
-        auto end = tell();
-        return {syntax::token::HeaderName(name, false, path_, start.line, end.line, start.col, end.col), {}, false};
+        auto [line_start, col_start] = lineAndColumn(start.ptr);
+        auto [line_end, col_end] = lineAndColumn(ptr);
+        return {
+            syntax::token::HeaderName(name, false, location(start.ptr), line_start, line_end, col_start, col_end),
+            false};
     }
-    return {std::nullopt, {}, false};
+    return {std::nullopt, false};
 }
 
-Lexer::Return<PreprocessingToken> Lexer::getIdentifier() {
+Lexer::Return<Lexer::Lexeme> Lexer::getIdentifier() {
     auto start = tell();
     if (utils::isIdentifierStartChar(*ptr)) {
-        std::string name;
-        name.push_back(*ptr);
-        adv();
-        while (utils::isIdentifierChar(*ptr)) {
-            name.push_back(*ptr);
-            adv();
-        }
-        auto end = tell();
-        return {syntax::token::Identifier(name, path_, start.line, end.line, start.col, end.col), {}, false};
+        // hash while scanning so interning does not read the spelling a second time
+        auto hash = core::types::StringInterner::hashStep(core::types::StringInterner::hash_seed, *ptr);
+        const char* p = ptr + 1;
+        while (utils::isIdentifierChar(*p))
+            hash = core::types::StringInterner::hashStep(hash, *p++);
+        advTo(p);
+        // keywords are recognized here already, so later stages do not compare identifier names again
+        if (auto type = syntax::token::keywordTypeFromStr(spelling(start)); type.has_value())
+            return {Lexeme(syntax::token::toTokenKind(type.value()), start, tell()), false};
+        Lexeme lexeme(TokenKind::Identifier, start, tell());
+        lexeme.symbol = interner.intern(spelling(start), hash);
+        return {std::move(lexeme), false};
     }
-    return {std::nullopt, {}, false};
+    return {std::nullopt, false};
+}
+
+// end of the preprocessing number that continues at p
+static const char* ppNumberEnd(const char* p) {
+    while (utils::isIdentifierChar(*p) or *p == '.' or (utils::isSignChar(*p) and utils::isExponentChar(p[-1])))
+        p++;
+    return p;
 }
 
-Lexer::Return<PreprocessingToken> Lexer::getIntegerConstant() {
+Lexer::Return<Lexer::Lexeme> Lexer::getNumber() {
+    // A preprocessing number is a digit or '.' digit followed by digits, identifier characters, '.' and a sign after
+    // e or E. It is scanned once: the part the constant grammar accepts decides between integer and floating, and
+    // the rest of the pp-number is the suffix.
     auto start = tell();
-    if (std::isdigit(*ptr)) {
-        std::string source;
-        // parse base
+    if (utils::isDigit(*ptr) or (*ptr == '.' and utils::isDigit(lookForward()))) {
+        const char* p = ptr;
         utils::Base base = utils::Base::Decimal;
-        if (utils::hasBase(*ptr, lookForward(), lookForward(2))) {
-            source.push_back(*ptr);
-            adv();
-            if (utils::isHexBaseChar(*ptr)) {
-                base = utils::Base::Hexadecimal;
-                source.push_back(*ptr);
-                adv();
-            } else {
-                base = utils::Base::Octal;
-            }
+        if (utils::hasBase(p[0], p[1], p[2])) {
+            base = utils::isHexBaseChar(p[1]) ? utils::Base::Hexadecimal : utils::Base::Octal;
+            p += base == utils::Base::Hexadecimal ? 2 : 1;
         }
 
-        // parse value
-        std::intmax_t value = 0;
+        const char* digits = p;
+        bool is_float = false;
         if (base == utils::Base::Hexadecimal) {
-            while (std::isxdigit(*ptr)) {
-                value = value * 16 + utils::charToInt(*ptr);
-                source.push_back(*ptr);
-                adv();
-            }
+            while (utils::isHexDigit(*p))
+                p++;
         } else {
-            while (std::isdigit(*ptr)) {
-                if (base == utils::Base::Octal and not utils::isOctDigit(*ptr))
-                    return {std::nullopt, {Message::error(path_, line, col, "invalid digit in octal constant")}, true};
-                value = value * (base == utils::Base::Octal ? 8 : 10) + utils::charToInt(*ptr);
-                source.push_back(*ptr);
-                adv();
+            while (utils::isDigit(*p))
+                p++;
+            // C89 only supports decimal floating constant, which may have leading zeros
+            if (*p == '.') {
+                is_float = true;
+                p++;
+                while (utils::isDigit(*p))
+                    p++;
+            }
+            if (utils::hasExponent(p[0], p[1])) {
+                const char* exponent = p;
+                p += utils::isSignChar(p[1]) ? 2 : 1;
+                if (not utils::isDigit(*p)) {
+                    advTo(ppNumberEnd(p));
+                    return fail(Message::error(location(exponent), "floating constant has no exponent digits"));
+                }
+                is_float = true;
+                while (utils::isDigit(*p))
+                    p++;
             }
         }
 
-        // parse suffix
-        std::string suffix_str;
-        auto suffix_start = tell();
-        while (utils::isIdentifierChar(*ptr)) {
-            suffix_str.push_back(*ptr);
-            source.push_back(*ptr);
-            adv();
-        }
-        auto suffix = syntax::token::integerSuffixFromStr(suffix_str);
-        if (not suffix.has_value())
-            return {
-                std::nullopt,
-                {Message::error(path_, suffix_start.line, suffix_start.col, "invalid integer constant suffix")},
-                true};
-
-        auto end = tell();
-        return {
-            syntax::token::IntegerConstant(
-                value, suffix.value(), std::move(source), path_, start.line, end.line, start.col, end.col),
-            {},
-            false};
+        const char* suffix = p;
+        advTo(ppNumberEnd(p));
+
+        if (is_float)
+            return getFloatingConstant(start, suffix);
+        return getIntegerConstant(start, digits, suffix, base);
     }
-    return {std::nullopt, {}, false};
+    return {std::nullopt, false};
 }
 
-Lexer::Return<PreprocessingToken> Lexer::getFloatingConstant() {
-    // C89 only supports decimal floating constant
-    auto start = tell();
-    if (std::isdigit(*ptr) or (*ptr == '.' and std::isdigit(lookForward()))) {
-        bool is_float = false;
-        std::string value_str, suffix_str;
-        std::string source;
-
-        // parse significand
-        if (*ptr == '.')
-            is_float = true;
-        value_str.push_back(*ptr);
-        source.push_back(*ptr);
-        adv();
-        while (std::isdigit(*ptr)) {
-            value_str.push_back(*ptr);
-            source.push_back(*ptr);
-            adv();
-        }
-        if (*ptr == '.') {
-            if (not is_float) {
-                is_float = true;
-                value_str.push_back(*ptr);
-                source.push_back(*ptr);
-                adv();
-                while (std::isdigit(*ptr)) {
-                    value_str.push_back(*ptr);
-                    source.push_back(*ptr);
-                    adv();
-                }
-            } else {
-                return {std::nullopt, {Message::error(path_, line, col, "invalid floating constant")}, true};
-            }
-        }
+Lexer::Return<Lexer::Lexeme> Lexer::getIntegerConstant(
+    const Position& start, const char* digits, const char* suffix_start, utils::Base base) {
+    if (base == utils::Base::Octal)
+        for (const char* digit = digits; digit < suffix_start; digit++)
+            if (not utils::isOctDigit(*digit))
+                return fail(Message::error(location(digit), "invalid digit in octal constant"));
+    auto value = integer::decode(digits, suffix_start, base);
+
+    auto suffix = syntax::token::integerSuffixFromStr({suffix_start, static_cast<std::size_t>(ptr - suffix_start)});
+    if (not suffix.has_value())
+        return fail(Message::error(location(suffix_start), "invalid integer constant suffix"));
+
+    auto type = value.has_value() ? integer::selectType(value.value(), suffix.value(), base) : std::nullopt;
+    if (not type.has_value())
+        return fail(Message::error(location(start.ptr), "integer constant is too large"));
+    // C89 lets a decimal constant without u become unsigned long when it does not fit in long
+    bool became_unsigned =
+        type == syntax::token::IntegerType::UnsignedLong or type == syntax::token::IntegerType::UnsignedLongLong;
+    if (base == utils::Base::Decimal and became_unsigned and
+        (suffix == syntax::token::IntegerSuffix::None or suffix == syntax::token::IntegerSuffix::Long))
+        diags.report(Message::warning(location(start.ptr), "integer constant is so large that it is unsigned"));
+
+    Lexeme lexeme(TokenKind::IntegerConstant, start, tell());
+    lexeme.integer = value.value();
+    lexeme.integer_suffix = suffix.value();
+    lexeme.integer_type = type.value();
+    return {std::move(lexeme), false};
+}
 
-        // parse exponent
-        auto exp_start = tell();
-        if (utils::hasExponent(*ptr, lookForward())) {
-            is_float = true;
-            value_str.push_back(*ptr);
-            source.push_back(*ptr);
-            adv();
-            if (utils::isSignChar(*ptr)) {
-                value_str.push_back(*ptr);
-                source.push_back(*ptr);
-                adv();
-            }
-            bool has_exponent_digits = false;
-            while (std::isdigit(*ptr)) {
-                has_exponent_digits = true;
-                value_str.push_back(*ptr);
-                source.push_back(*ptr);
-                adv();
-            }
-            if (not has_exponent_digits) {
-                return {
-                    std::nullopt,
-                    {Message::error(path_, exp_start.line, exp_start.col, "floating constant has no exponent digits")},
-                    true};
-            }
-        }
+Lexer::Return<Lexer::Lexeme> Lexer::getFloatingConstant(const Position& start, const char* suffix_start) {
+    // a second '.' as in 1.2.3 still belongs to the pp-number
+    if (*suffix_start == '.')
+        return fail(Message::error(location(suffix_start), "invalid floating constant"));
+    auto suffix = syntax::token::floatingSuffixFromStr({suffix_start, static_cast<std::size_t>(ptr - suffix_start)});
+    if (not suffix.has_value())
+        return fail(Message::error(location(suffix_start), "invalid floating constant suffix"));
+
+    // the logical source is contiguous, so the digits are converted in place
+    auto [value, range] = floating::decode(start.ptr, suffix_start, suffix.value());
+    if (range == floating::Range::Overflow)
+        diags.report(Message::warning(location(start.ptr), "floating constant exceeds the range of its type"));
+    else if (range == floating::Range::Underflow)
+        diags.report(Message::warning(location(start.ptr), "floating constant truncated to zero"));
+
+    Lexeme lexeme(TokenKind::FloatingConstant, start, tell());
+    lexeme.floating = value;
+    lexeme.floating_suffix = suffix.value();
+    return {std::move(lexeme), false};
+}
+
+// after the closing quote of the literal that continues at p, or at the end of its line when it has none
+static const char* literalEnd(const char* p, char quote) {
+    while (true) {
+        p = scan::findLiteralEnd(p, quote);
+        if (*p == quote)
+            return p + 1;
+        if (*p != '\\')
+            return p;
+        p += utils::isEndOfLineChar(p[1]) ? 1 : 2;
+    }
+}
+
+Lexer::Return<std::string_view> Lexer::getLiteralBody(const Position& start) {
+    const char quote = *ptr;
+    const char* body = ptr + 1;
+    const char* p = scan::findLiteralEnd(body, quote);
+    // most literals have no escapes, so their value is the source text itself
+    if (*p == quote) {
+        advTo(p + 1);
+        return {std::string_view(body, p - body), false};
+    }
 
-        if (not is_float) {
-            seek(start);
-            return {std::nullopt, {}, false};
+    literal_storage.assign(body, p);
+    while (*p != quote) {
+        if (*p != '\\') {
+            advTo(p);
+            return fail(Message::error(
+                location(start.ptr),
+                quote == '\'' ? "missing closing single quote" : "missing closing double quote"));
         }
 
-        // parse suffix
-        auto suffix_start = tell();
-        while (utils::isIdentifierChar(*ptr)) {
-            suffix_str.push_back(*ptr);
-            source.push_back(*ptr);
-            adv();
+        const char* escape = p++;
+        if (utils::isSimpleEscapeChar(*p)) {
+            literal_storage.push_back(utils::simpleEscape(*p++));
+        } else if (*p == 'x') {
+            std::uintmax_t hex = 0;
+            if (not utils::isHexDigit(*++p)) {
+                advTo(literalEnd(p, quote));
+                return fail(Message::error(location(p), "hex escape sequence has no hexadecimal digits"));
+            }
+            // the digits may go on forever: past UCHAR_MAX the value is out of range anyway and stops growing
+            for (; utils::isHexDigit(*p); p++)
+                if (hex <= std::numeric_limits<unsigned char>::max())
+                    hex = hex * 16 + utils::charToInt(*p);
+            if (hex > static_cast<std::uintmax_t>(std::numeric_limits<char>::max()))
+                diags.report(Message::warning(location(escape), "hex escape sequence out of range"));
+            literal_storage.push_back(static_cast<char>(hex));
+        } else if (utils::isOctDigit(*p)) {
+            std::intmax_t oct = 0;
+            for (int count = 0; utils::isOctDigit(*p) and count < 3; count++)
+                oct = oct * 8 + utils::charToInt(*p++);
+            if (oct > std::numeric_limits<char>::max() or oct < std::numeric_limits<char>::min())
+                diags.report(Message::warning(location(escape), "oct escape sequence out of range"));
+            literal_storage.push_back(static_cast<char>(oct));
+        } else if (utils::isEndOfLineChar(*p)) {
+            continue;
+        } else {
+            diags.report(Message::warning(location(escape), "unknown escape sequence"));
+            literal_storage.push_back(*p++);
         }
-        auto suffix = syntax::token::floatingSuffixFromStr(suffix_str);
-        if (not suffix.has_value())
-            return {
-                std::nullopt,
-                {Message::error(path_, suffix_start.line, suffix_start.col, "invalid floating constant suffix")},
-                true};
-
-        auto end = tell();
-        return {
-            syntax::token::FloatingConstant(
-                std::stold(value_str),
-                suffix.value(),
-                std::move(source),
-                path_,
-                start.line,
-                end.line,
-                start.col,
-                end.col),
-            {},
-            false};
+
+        // copy the clean run up to the next escape in one go
+        const char* run = p;
+        p = scan::findLiteralEnd(run, quote);
+        literal_storage.append(run, p);
     }
-    return {std::nullopt, {}, false};
+    advTo(p + 1);
+    return {std::string_view(literal_storage), false};
 }
 
-Lexer::Return<PreprocessingToken> Lexer::getCharacterConstant() {
+Lexer::Return<Lexer::Lexeme> Lexer::getCharacterConstant() {
     auto start = tell();
     if (*ptr == '\'') {
-        std::string value_str;
-        std::string source;
-        std::vector<Message> msg;
-
-        adv();
-        while (*ptr != '\'') {
-            if (*ptr == '\\') {
-                auto esc_start = tell();
-                source.push_back(*ptr);
-                adv();
-                if (utils::isSimpleEscapeChar(*ptr)) {
-                    value_str.push_back(utils::simpleEscape(*ptr));
-                    source.push_back(*ptr);
-                    adv();
-                } else if (*ptr == 'x') {
-                    std::intmax_t hex = 0;
-                    source.push_back(*ptr);
-                    adv();
-                    if (not std::isxdigit(*ptr))
-                        return {
-                            std::nullopt,
-                            {Message::error(path_, line, col, "hex escape sequence has no hexadecimal digits")},
-                            true};
-                    while (std::isxdigit(*ptr)) {
-                        hex = hex * 16 + utils::charToInt(*ptr);
-                        source.push_back(*ptr);
-                        adv();
-                    }
-                    if (hex > std::numeric_limits<char>::max() or hex < std::numeric_limits<char>::min())
-                        msg.push_back(
-                            Message::warning(path_, esc_start.line, esc_start.col, "hex escape sequence out of range"));
-                    value_str.push_back(static_cast<char>(hex));
-                } else if (utils::isOctDigit(*ptr)) {
-                    std::intmax_t oct = 0;
-                    int count = 0;
-                    while (utils::isOctDigit(*ptr) and count < 3) {
-                        oct = oct * 8 + utils::charToInt(*ptr);
-                        source.push_back(*ptr);
-                        adv();
-                        count++;
-                    }
-                    if (oct > std::numeric_limits<char>::max() or oct < std::numeric_limits<char>::min())
-                        msg.push_back(
-                            Message::warning(path_, esc_start.line, esc_start.col, "oct escape sequence out of range"));
-                    value_str.push_back(static_cast<char>(oct));
-                } else if (utils::isEndOfLineChar(*ptr)) {
-                    return {
-                        std::nullopt,
-                        {Message::error(path_, start.line, start.col, "missing closing single quote")},
-                        true};
-                } else {
-                    msg.push_back(Message::warning(path_, esc_start.line, esc_start.col, "unknown escape sequence"));
-                    value_str.push_back(*ptr);
-                    source.push_back(*ptr);
-                    adv();
-                }
-            } else if (utils::isEndOfLineChar(*ptr)) {
-                return {
-                    std::nullopt, {Message::error(path_, start.line, start.col, "missing closing single quote")}, true};
-            } else {
-                value_str.push_back(*ptr);
-                source.push_back(*ptr);
-                adv();
-            }
-        }
-        adv();
+        auto body = getLiteralBody(start);
+        if (not body.tok.has_value())
+            return {std::nullopt, body.error};
 
+        auto value_str = body.tok.value();
         if (value_str.size() == 0)
-            return {std::nullopt, {Message::error(path_, start.line, start.col, "empty character constant")}, true};
+            return fail(Message::error(location(start.ptr), "empty character constant"));
         if (value_str.size() > 1)
-            msg.push_back(Message::warning(path_, start.line, start.col, "multi-character character constant"));
+            diags.report(Message::warning(location(start.ptr), "multi-character character constant"));
 
-        std::intmax_t value = 0;
+        // unsigned, so that a constant longer than intmax_t wraps instead of overflowing
+        std::uintmax_t value = 0;
         for (char c : value_str)
-            value = value * 256 + c;
+            value = value * 256 + static_cast<std::uintmax_t>(c);
 
-        auto end = tell();
-        return {
-            syntax::token::CharacterConstant(value, std::move(source), path_, start.line, end.line, start.col, end.col),
-            msg,
-            false};
+        Lexeme lexeme(TokenKind::CharacterConstant, start, tell());
+        lexeme.character = static_cast<std::intmax_t>(value);
+        return {std::move(lexeme), false};
     }
-    return {std::nullopt, {}, false};
+    return {std::nullopt, false};
 }
 
-Lexer::Return<PreprocessingToken> Lexer::getStringLiteral() {
+Lexer::Return<Lexer::Lexeme> Lexer::getStringLiteral() {
     auto start = tell();
     if (*ptr == '"') {
-        std::string value;
-        std::string source;
-        std::vector<Message> msg;
-
-        adv();
-        while (*ptr != '"') {
-            if (*ptr == '\\') {
-                auto esc_start = tell();
-                source.push_back(*ptr);
-                adv();
-                if (utils::isSimpleEscapeChar(*ptr)) {
-                    value.push_back(utils::simpleEscape(*ptr));
-                    source.push_back(*ptr);
-                    adv();
-                } else if (*ptr == 'x') {
-                    std::intmax_t hex = 0;
-                    source.push_back(*ptr);
-                    adv();
-                    if (not std::isxdigit(*ptr))
-                        return {
-                            std::nullopt,
-                            {Message::error(path_, line, col, "hex escape sequence has no hexadecimal digits")},
-                            true};
-                    while (std::isxdigit(*ptr)) {
-                        hex = hex * 16 + utils::charToInt(*ptr);
-                        source.push_back(*ptr);
-                        adv();
-                    }
-                    if (hex > std::numeric_limits<char>::max() or hex < std::numeric_limits<char>::min())
-                        msg.push_back(
-                            Message::warning(path_, esc_start.line, esc_start.col, "hex escape sequence out of range"));
-                    value.push_back(static_cast<char>(hex));
-                } else if (utils::isOctDigit(*ptr)) {
-                    std::intmax_t oct = 0;
-                    int count = 0;
-                    while (utils::isOctDigit(*ptr) and count < 3) {
-                        oct = oct * 8 + utils::charToInt(*ptr);
-                        source.push_back(*ptr);
-                        adv();
-                        count++;
-                    }
-                    if (oct > std::numeric_limits<char>::max() or oct < std::numeric_limits<char>::min())
-                        msg.push_back(
-                            Message::warning(path_, esc_start.line, esc_start.col, "oct escape sequence out of range"));
-                    value.push_back(static_cast<char>(oct));
-                } else if (utils::isEndOfLineChar(*ptr)) {
-                    return {
-                        std::nullopt,
-                        {Message::error(path_, start.line, start.col, "missing closing single quote")},
-                        true};
-                } else {
-                    msg.push_back(Message::warning(path_, esc_start.line, esc_start.col, "unknown escape sequence"));
-                    value.push_back(*ptr);
-                    source.push_back(*ptr);
-                    adv();
-                }
-            } else if (utils::isEndOfLineChar(*ptr)) {
-                return {
-                    std::nullopt, {Message::error(path_, start.line, start.col, "missing closing single quote")}, true};
-            } else {
-                value.push_back(*ptr);
-                source.push_back(*ptr);
-                adv();
-            }
-        }
-        adv();
+        auto body = getLiteralBody(start);
+        if (not body.tok.has_value())
+            return {std::nullopt, body.error};
 
-        auto end = tell();
-        return {
-            syntax::token::StringLiteral(value, std::move(source), path_, start.line, end.line, start.col, end.col),
-            msg,
-            false};
+        Lexeme lexeme(TokenKind::StringLiteral, start, tell());
+        lexeme.value = body.tok.value();
+        return {std::move(lexeme), false};
     }
-    return {std::nullopt, {}, false};
-}
-
-static PreprocessingToken buildPunctuation(
-    syntax::token::PunctuationType type,
-    const std::string& file,
-    size_t line_start,
-    size_t line_end,
-    size_t col_start,
-    size_t col_end) {
-    switch (type) {
-        case syntax::token::PunctuationType::DoubleLessThanEqual:
-            return syntax::token::DoubleLessThanEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleGreaterThanEqual:
-            return syntax::token::DoubleGreaterThanEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Ellipsis:
-            return syntax::token::Ellipsis(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Arrow:
-            return syntax::token::Arrow(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoublePlus:
-            return syntax::token::DoublePlus(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleMinus:
-            return syntax::token::DoubleMinus(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleLessThan:
-            return syntax::token::DoubleLessThan(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleGreaterThan:
-            return syntax::token::DoubleGreaterThan(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::LessThanEqual:
-            return syntax::token::LessThanEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::GreaterThanEqual:
-            return syntax::token::GreaterThanEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleEqual:
-            return syntax::token::DoubleEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::ExclamationEqual:
-            return syntax::token::ExclamationEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleAmpersand:
-            return syntax::token::DoubleAmpersand(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleVerticalBar:
-            return syntax::token::DoubleVerticalBar(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::AsteriskEqual:
-            return syntax::token::AsteriskEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::SlashEqual:
-            return syntax::token::SlashEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::PercentEqual:
-            return syntax::token::PercentEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::PlusEqual:
-            return syntax::token::PlusEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::MinusEqual:
-            return syntax::token::MinusEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::AmpersandEqual:
-            return syntax::token::AmpersandEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::CaretEqual:
-            return syntax::token::CaretEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::VerticalBarEqual:
-            return syntax::token::VerticalBarEqual(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::DoubleHash:
-            return syntax::token::DoubleHash(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::OpenBracket:
-            return syntax::token::OpenBracket(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::CloseBracket:
-            return syntax::token::CloseBracket(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::OpenParenthesis:
-            return syntax::token::OpenParenthesis(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::CloseParenthesis:
-            return syntax::token::CloseParenthesis(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::OpenBrace:
-            return syntax::token::OpenBrace(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::CloseBrace:
-            return syntax::token::CloseBrace(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Dot:
-            return syntax::token::Dot(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Ampersand:
-            return syntax::token::Ampersand(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Asterisk:
-            return syntax::token::Asterisk(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Plus:
-            return syntax::token::Plus(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Minus:
-            return syntax::token::Minus(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Tilde:
-            return syntax::token::Tilde(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Exclamation:
-            return syntax::token::Exclamation(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Slash:
-            return syntax::token::Slash(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Percent:
-            return syntax::token::Percent(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::LessThan:
-            return syntax::token::LessThan(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::GreaterThan:
-            return syntax::token::GreaterThan(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Caret:
-            return syntax::token::Caret(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::VerticalBar:
-            return syntax::token::VerticalBar(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Question:
-            return syntax::token::Question(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Colon:
-            return syntax::token::Colon(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Semicolon:
-            return syntax::token::Semicolon(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Equal:
-            return syntax::token::Equal(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Comma:
-            return syntax::token::Comma(file, line_start, line_end, col_start, col_end);
-        case syntax::token::PunctuationType::Hash:
-            return syntax::token::Hash(file, line_start, line_end, col_start, col_end);
-    }
-    throw core::types::Exception("Unknown punctuation type");
+    return {std::nullopt, false};
 }
 
-Lexer::Return<PreprocessingToken> Lexer::getPunctuation() {
-    std::string str;
-    str.push_back(*ptr);
-    if (char c = lookForward(); std::ispunct(c)) {
-        str.push_back(c);
-        if (char c = lookForward(2); std::ispunct(c))
-            str.push_back(c);
-    }
-
+Lexer::Return<Lexer::Lexeme> Lexer::getPunctuation() {
     auto start = tell();
-    while (not str.empty()) {
-        if (auto punct = syntax::token::punctuationTypeFromStr(str); punct.has_value()) {
-            adv(str.size());
-            auto end = tell();
-            return {buildPunctuation(punct.value(), path_, start.line, end.line, start.col, end.col), {}, false};
-        }
-        str.pop_back();
-    }
-    return {std::nullopt, {}, false};
+    auto punct = syntax::token::matchPunctuation(ptr);
+    if (not punct.has_value())
+        return {std::nullopt, false};
+    adv(punct->length);
+    return {Lexeme(syntax::token::toTokenKind(punct->type), start, tell()), false};
 }
 
 }  // namespace cless::fend::lexer
@@ -0,0 +1,63 @@
+#include "cless/front-end/lexer/spliced_source.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace cless::fend::lexer {
+
+static const char* findSplice(const char* p, const char* end) {
+    while (p < end) {
+        p = static_cast<const char*>(std::memchr(p, '\\', end - p));
+        if (p == nullptr or *(p + 1) == '\n')
+            return p;
+        p++;
+    }
+    return nullptr;
+}
+
+SplicedSource::SplicedSource() : physical(nullptr) {}
+
+SplicedSource::SplicedSource(const core::source::SourceBuffer& physical) : physical(&physical) {
+    const char* begin = physical.data();
+    const char* end = begin + physical.size();
+
+    const char* p = findSplice(begin, end);
+    if (p == nullptr)
+        return;
+
+    std::string text;
+    text.reserve(physical.size());
+    const char* run = begin;
+    while (p != nullptr) {
+        text.append(run, p);
+        splices.push_back(text.size());
+        run = p + 2;
+        p = findSplice(run, end);
+    }
+    text.append(run, end);
+    logical = core::source::SourceBuffer::fromString(text);
+}
+
+const char* SplicedSource::data() const {
+    return hasSplices() ? logical.data() : physical->data();
+}
+
+std::size_t SplicedSource::size() const {
+    return hasSplices() ? logical.size() : physical->size();
+}
+
+bool SplicedSource::hasSplices() const {
+    return not splices.empty();
+}
+
+const std::vector<std::size_t>& SplicedSource::spliceOffsets() const {
+    return splices;
+}
+
+std::size_t SplicedSource::toPhysical(std::size_t offset) const {
+    auto removed = std::upper_bound(splices.begin(), splices.end(), offset) - splices.begin();
+    return offset + 2 * static_cast<std::size_t>(removed);
+}
+
+}  // namespace cless::fend::lexer
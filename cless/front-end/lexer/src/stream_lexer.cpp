@@ -0,0 +1,90 @@
+#include "cless/front-end/lexer/stream_lexer.h"
+
+#include <utility>
+
+namespace cless::fend::lexer {
+using core::types::Message;
+
+StreamLexer::StreamLexer(
+    core::source::SourceManager& sources,
+    core::types::DiagnosticsEngine& diags,
+    core::types::StringInterner& interner,
+    int fd,
+    std::string path,
+    std::size_t window_size)
+    : sources(sources),
+      diags(diags),
+      interner(interner),
+      path_(std::move(path)),
+      stream(fd, window_size),
+      in_comment(false),
+      recovery(false),
+      done(false) {}
+
+StreamLexer::~StreamLexer() {
+    releaseWindow();
+    releaseCommentWindow();
+}
+
+std::optional<Lexer::Batch> StreamLexer::next() {
+    releaseWindow();
+    if (done)
+        return std::nullopt;
+    auto text = stream.next();
+    if (not text.has_value()) {
+        done = true;
+        if (stream.failed())
+            diags.report(Message::error(core::source::SourceLocation(), "cannot read " + path_));
+        else if (in_comment)
+            diags.report(Message::error(comment_start, "unterminated /* comment"));
+        releaseCommentWindow();
+        return std::nullopt;
+    }
+    window = sources.addBuffer(path_, std::move(text->text), text->first_line);
+    if (not window.has_value()) {
+        done = true;
+        diags.report(Message::error(core::source::SourceLocation(), path_ + " is too large"));
+        return std::nullopt;
+    }
+
+    // line and column are only resolved for tokens and messages that get printed, while the window is still there
+    Lexer lexer(sources, diags, interner, window.value(), Lexer::PositionMode::OffsetOnly);
+    lexer.setErrorRecovery(recovery);
+    lexer.setStreamWindow(true);
+    if (in_comment)
+        lexer.continueComment();
+    auto batch = lexer.tokenizeAll();
+    in_comment = lexer.inComment();
+    if (auto opened = lexer.openedComment(); in_comment and opened.has_value()) {
+        // this window now holds the "/*" of the open comment
+        releaseCommentWindow();
+        comment_start = opened.value();
+        comment_window = std::exchange(window, std::nullopt);
+    } else if (not in_comment) {
+        releaseCommentWindow();
+    }
+    done = batch.error;
+    return batch;
+}
+
+void StreamLexer::setErrorRecovery(bool enable) {
+    recovery = enable;
+}
+
+const std::string& StreamLexer::path() const {
+    return path_;
+}
+
+void StreamLexer::releaseWindow() {
+    if (window.has_value())
+        sources.release(window.value());
+    window.reset();
+}
+
+void StreamLexer::releaseCommentWindow() {
+    if (comment_window.has_value())
+        sources.release(comment_window.value());
+    comment_window.reset();
+}
+
+}  // namespace cless::fend::lexer
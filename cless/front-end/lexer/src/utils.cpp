@@ -49,42 +49,6 @@ std::intmax_t charToInt(char c) {
     throw core::types::Exception("Invalid digit");
 }
 
-bool isEndOfLineChar(char c) {
-    return c == '\n' or c == '\0';
-}
-
-bool isIdentifierChar(char c) {
-    return std::isalnum(c) or c == '_';
-}
-
-bool isIdentifierStartChar(char c) {
-    return std::isalpha(c) or c == '_';
-}
-
-bool isHexBaseChar(char c) {
-    return c == 'x' or c == 'X';
-}
-
-bool hasBase(char curr, char next, char next_next) {
-    return (curr == '0' and std::isdigit(next)) or (curr == '0' and isHexBaseChar(next) and std::isxdigit(next_next));
-}
-
-bool isOctDigit(char c) {
-    return std::isdigit(c) and c != '8' and c != '9';
-}
-
-bool isExponentChar(char c) {
-    return c == 'e' or c == 'E';
-}
-
-bool isSignChar(char c) {
-    return c == '+' or c == '-';
-}
-
-bool hasExponent(char curr, char next) {
-    return isExponentChar(curr) and (isSignChar(next) or std::isdigit(next));
-}
-
 bool isSimpleEscapeChar(char c) {
     switch (c) {
         case '\'':
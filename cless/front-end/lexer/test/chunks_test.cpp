@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "cless/core/parallel/thread_pool.h"
+#include "cless/front-end/lexer/lexer.h"
+
+namespace {
+namespace source = cless::core::source;
+namespace types = cless::core::types;
+using cless::fend::lexer::Lexer;
+using cless::syntax::token::TokenKind;
+
+struct Lexed {
+    std::vector<std::tuple<TokenKind, std::uint32_t, std::uint32_t, std::string, std::string>> tokens;
+    std::vector<std::tuple<types::Message::Type, std::uint32_t, std::string>> messages;
+    bool error;
+};
+
+struct Options {
+    bool recovery = true;
+    std::size_t error_limit = 0;
+};
+
+// lexes text on its own, on pool in chunks of at least chunk_size bytes if a pool is given
+Lexed lex(
+    const std::string& text,
+    const Options& options,
+    cless::core::parallel::ThreadPool* pool,
+    std::size_t chunk_size) {
+    source::SourceManager sources;
+    Lexed lexed;
+    types::DiagnosticsEngine diags([&lexed](const types::Message& msg) {
+        lexed.messages.emplace_back(msg.type, msg.location.value(), msg.message);
+    });
+    diags.setErrorLimit(options.error_limit);
+    types::StringInterner interner;
+    auto file = sources.addBuffer("chunks.c", source::SourceBuffer::fromString(text));
+    Lexer lexer(sources, diags, interner, file.value());
+    lexer.setErrorRecovery(options.recovery);
+    auto batch = pool != nullptr ? lexer.tokenizeAll(*pool, chunk_size) : lexer.tokenizeAll();
+    for (std::size_t i = 0; i < batch.tokens.size(); i++) {
+        auto token = batch.tokens[i];
+        auto kind = batch.tokens.kind(i);
+        std::string value;
+        if (kind == TokenKind::StringLiteral)
+            value = batch.tokens.string(i);
+        else if (kind == TokenKind::CharacterConstant)
+            value = std::to_string(batch.tokens.character(i));
+        else if (kind == TokenKind::IntegerConstant)
+            value = std::to_string(batch.tokens.integer(i).value);
+        lexed.tokens.emplace_back(kind, token.offset, token.length, std::string(batch.tokens.text(i)), value);
+    }
+    lexed.error = batch.error;
+    return lexed;
+}
+
+// every chunk size from a cut after every line up to a few lines per chunk, on one thread and on several
+void expectSameAsSequential(const std::string& text, const Options& options = {}) {
+    auto expected = lex(text, options, nullptr, 0);
+    for (std::size_t threads : {1, 4}) {
+        cless::core::parallel::ThreadPool pool(threads);
+        for (std::size_t chunk_size = 0; chunk_size <= 64; chunk_size += 4) {
+            SCOPED_TRACE("threads " + std::to_string(threads) + ", chunk size " + std::to_string(chunk_size));
+            auto actual = lex(text, options, &pool, chunk_size);
+            EXPECT_EQ(actual.tokens, expected.tokens);
+            EXPECT_EQ(actual.messages, expected.messages);
+            EXPECT_EQ(actual.error, expected.error);
+        }
+    }
+}
+
+std::string repeat(const std::string& text, std::size_t times) {
+    std::string result;
+    for (std::size_t i = 0; i < times; i++)
+        result += text;
+    return result;
+}
+
+TEST(ChunksTest, Code) {
+    expectSameAsSequential(repeat("int main(void) {\n    return x[1] + 2.5f * 'c';\n}\n", 20));
+}
+
+TEST(ChunksTest, CommentsAcrossChunks) {
+    expectSameAsSequential(repeat("x = 1; /* a comment\n over\n several lines */ y;\n// line\n", 20));
+    expectSameAsSequential(repeat("/*\n *\n *\n */\nz;\n", 20));
+}
+
+TEST(ChunksTest, UnterminatedCommentIsReportedOnce) {
+    auto text = repeat("int x = 1;\n", 20) + "z /* open\n" + repeat("/* inner\n", 30);
+    expectSameAsSequential(text);
+    auto lexed = lex(text, {}, nullptr, 0);
+    ASSERT_EQ(lexed.messages.size(), 1u);
+    EXPECT_EQ(std::get<2>(lexed.messages.front()), "unterminated /* comment");
+}
+
+TEST(ChunksTest, CommentOpenersInLiterals) {
+    expectSameAsSequential(repeat("s = \"a /* b\";\nc = '/';\nt = \"\\\" /*\";\nu = \"*/\";\n", 20));
+}
+
+TEST(ChunksTest, Splices) {
+    expectSameAsSequential(repeat("in\\\nt x = 1; /* a *\\\n/ y;\n// c \\\nd\ns = \"a\\\nb\";\n", 20));
+}
+
+TEST(ChunksTest, Errors) {
+    auto text = repeat("@ x;\n\"abc\n'';\n0x;\n", 20);
+    expectSameAsSequential(text);
+    expectSameAsSequential(text, {.recovery = false});
+    expectSameAsSequential(text, {.recovery = true, .error_limit = 7});
+}
+
+TEST(ChunksTest, Mixed) {
+    const std::vector<std::string> lines = {
+        "int a = 0x1f;\n", "/* open\n", "still */ b;\n", "// c /* d\n", "s = \"/* e\";\n", "@\n",
+        "x\\\ny;\n", "/**/\n", "'\\n' '\\x41';\n", "*/\n", "\"f\n", "\n",
+    };
+    // splitmix64, so every run lexes the same texts
+    std::uint64_t state = 1;
+    auto next = [&state] {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    };
+    for (int seed = 0; seed < 20; seed++) {
+        std::string text;
+        for (int i = 0; i < 60; i++)
+            text += lines[next() % lines.size()];
+        SCOPED_TRACE(text);
+        expectSameAsSequential(text);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "cless/front-end/lexer/lexer.h"
+#include "cless/front-end/lexer/stream_lexer.h"
+
+namespace {
+namespace source = cless::core::source;
+namespace types = cless::core::types;
+using cless::fend::lexer::Lexer;
+using cless::fend::lexer::StreamLexer;
+using cless::syntax::token::TokenBuffer;
+using cless::syntax::token::TokenKind;
+
+// windows are files of their own, so tokens are compared by line and column instead of offset
+struct Lexed {
+    std::vector<std::tuple<TokenKind, std::size_t, std::size_t, std::string, std::string>> tokens;
+    std::vector<std::string> messages;
+    bool error = false;
+};
+
+void appendTokens(Lexed& lexed, const TokenBuffer& tokens) {
+    for (std::size_t i = 0; i < tokens.size(); i++) {
+        auto kind = tokens.kind(i);
+        std::string value;
+        if (kind == TokenKind::StringLiteral)
+            value = tokens.string(i);
+        else if (kind == TokenKind::CharacterConstant)
+            value = std::to_string(tokens.character(i));
+        else if (kind == TokenKind::IntegerConstant)
+            value = std::to_string(tokens.integer(i).value);
+        auto [line, column] = tokens.position(i);
+        lexed.tokens.emplace_back(kind, line, column, std::string(tokens.text(i)), value);
+    }
+}
+
+// lexes text whole, or from a pipe in windows of window_size bytes if it is not 0
+Lexed lex(const std::string& text, bool recovery, std::size_t window_size) {
+    source::SourceManager sources;
+    Lexed lexed;
+    types::DiagnosticsEngine diags([&](const types::Message& msg) {
+        std::ostringstream os;
+        types::printMessage(os, msg, sources);
+        lexed.messages.push_back(std::move(os).str());
+    });
+    types::StringInterner interner;
+    if (window_size == 0) {
+        auto file = sources.addBuffer("-", source::SourceBuffer::fromString(text));
+        Lexer lexer(sources, diags, interner, file.value());
+        lexer.setErrorRecovery(recovery);
+        auto batch = lexer.tokenizeAll();
+        appendTokens(lexed, batch.tokens);
+        lexed.error = batch.error;
+        return lexed;
+    }
+
+    int fds[2];
+    EXPECT_EQ(::pipe(fds), 0);
+    // written from another thread, so that a text larger than the pipe buffer does not block
+    std::thread writer([&text, fd = fds[1]] {
+        for (std::size_t written = 0; written < text.size();) {
+            auto n = ::write(fd, text.data() + written, text.size() - written);
+            if (n <= 0)
+                break;
+            written += static_cast<std::size_t>(n);
+        }
+        ::close(fd);
+    });
+    {
+        StreamLexer lexer(sources, diags, interner, fds[0], "-", window_size);
+        lexer.setErrorRecovery(recovery);
+        while (auto batch = lexer.next()) {
+            appendTokens(lexed, batch->tokens);
+            lexed.error = lexed.error or batch->error;
+        }
+    }
+    writer.join();
+    ::close(fds[0]);
+    return lexed;
+}
+
+// window sizes from one byte, where every line is longer than the buffer, to several lines per window
+void expectSameAsWhole(const std::string& text, bool recovery = true) {
+    auto expected = lex(text, recovery, 0);
+    for (std::size_t window_size : {1, 2, 3, 5, 7, 8, 13, 16, 32, 64, 256}) {
+        SCOPED_TRACE("window size " + std::to_string(window_size));
+        auto actual = lex(text, recovery, window_size);
+        EXPECT_EQ(actual.tokens, expected.tokens);
+        EXPECT_EQ(actual.messages, expected.messages);
+        EXPECT_EQ(actual.error, expected.error);
+    }
+}
+
+std::string repeat(const std::string& text, std::size_t times) {
+    std::string result;
+    for (std::size_t i = 0; i < times; i++)
+        result += text;
+    return result;
+}
+
+TEST(StreamLexerTest, Code) {
+    expectSameAsWhole(repeat("int main(void) {\n    return x[1] + 2.5f * 'c';\n}\n", 10));
+}
+
+TEST(StreamLexerTest, CommentsAcrossWindows) {
+    expectSameAsWhole(repeat("x = 1; /* a comment\n over\n several lines */ y;\n// line\n", 10));
+    expectSameAsWhole(repeat("/*\n *\n *\n */\nz;\n", 10));
+    expectSameAsWhole("a;\n/**\n" + repeat(" * banner\n", 20) + " */\nb;\n");
+}
+
+TEST(StreamLexerTest, UnterminatedComment) {
+    auto text = repeat("int x = 1;\n", 10) + "z /* open\n" + repeat("/* inner\n", 20);
+    expectSameAsWhole(text);
+    auto lexed = lex(text, true, 7);
+    ASSERT_EQ(lexed.messages.size(), 1u);
+    EXPECT_NE(lexed.messages.front().find("unterminated /* comment"), std::string::npos);
+}
+
+TEST(StreamLexerTest, SplicesBeforeCuts) {
+    expectSameAsWhole(repeat("in\\\nt x = 1; /* a *\\\n/ y;\n// c \\\nd\ns = \"a\\\nb\";\n", 10));
+    // every line ends in a splice up to the last one, so a window cannot end before it
+    expectSameAsWhole(repeat("a\\\n", 40) + "b;\nc;\n");
+}
+
+TEST(StreamLexerTest, LongLines) {
+    expectSameAsWhole(repeat("x", 300) + ";\n" + repeat("y + ", 100) + "1;\n\"" + repeat("s", 200) + "\";\n");
+    expectSameAsWhole("a /* " + repeat("long ", 100) + "*/ b;\n");
+}
+
+TEST(StreamLexerTest, Errors) {
+    auto text = repeat("@ x;\n\"abc\n'';\n0x;\n", 10);
+    expectSameAsWhole(text);
+    expectSameAsWhole(text, false);
+}
+
+TEST(StreamLexerTest, NoNewlineAtEnd) {
+    expectSameAsWhole("a;\nb + c");
+    expectSameAsWhole("a;\n/* open");
+}
+
+}  // namespace
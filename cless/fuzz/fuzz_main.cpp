@@ -0,0 +1,22 @@
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
+
+// Without libFuzzer, cless-fuzz runs the entry point once on each file given, to replay a crash or a corpus.
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (not file) {
+            std::cerr << "cless-fuzz: cannot read " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::string data(std::istreambuf_iterator<char>(file), {});
+        LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(data.data()), data.size());
+        std::cout << argv[i] << ": ok" << std::endl;
+    }
+}
@@ -0,0 +1,92 @@
+#include "harness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "cless/front-end/lexer/lexer.h"
+#include "cless/syntax/token/token_stream.h"
+
+namespace cless::fuzz {
+
+static void check(bool condition, const char* what, std::size_t index) {
+    if (condition)
+        return;
+    std::fprintf(stderr, "token %zu: %s\n", index, what);
+    std::abort();
+}
+
+// the tokens written as a binary stream and read back: every field and payload must come back, and the stream must
+// give the same text dump, and it must not open where long double has another format
+static void checkStream(const syntax::token::TokenBuffer& tokens) {
+    using syntax::token::TokenKind;
+    constexpr std::string_view path = "fuzz.c";
+    std::string stream;
+    check(syntax::token::writeTokenStream(tokens, path, stream), "do not fit a token stream", tokens.size());
+    auto view = syntax::token::TokenStreamView::open(stream);
+    check(view.has_value(), "stream does not open", tokens.size());
+    check(view->totalSize() == stream.size() and view->path() == path, "stream has a wrong header", tokens.size());
+    check(view->size() == tokens.size(), "stream has a different token count", tokens.size());
+    for (std::size_t i = 0; i < tokens.size(); i++) {
+        auto token = tokens[i];
+        auto [line, column] = tokens.position(i);
+        check(view->kind(i) == token.kind and view->offset(i) == token.offset and view->length(i) == token.length and
+                  view->line(i) == line and view->column(i) == column and view->text(i) == tokens.text(i),
+              "reads back different from the stream",
+              i);
+        switch (token.kind) {
+            case TokenKind::IntegerConstant:
+                check(view->integer(i).value == tokens.integer(i).value, "integer differs in the stream", i);
+                break;
+            case TokenKind::FloatingConstant:
+                check(view->floating(i).value == tokens.floating(i).value and
+                          view->floating(i).suffix == tokens.floating(i).suffix,
+                      "floating differs in the stream",
+                      i);
+                break;
+            case TokenKind::CharacterConstant:
+                check(view->character(i) == tokens.character(i), "character differs in the stream", i);
+                break;
+            case TokenKind::StringLiteral:
+                check(view->string(i) == tokens.string(i), "string differs in the stream", i);
+                break;
+            default:
+                break;
+        }
+    }
+    std::string expected, actual;
+    syntax::token::dumpTokens(tokens, expected);
+    syntax::token::dumpTokens(*view, actual);
+    check(actual == expected, "stream dumps different text", tokens.size());
+
+    // a stream of a host with another long double format must not open, whatever its tokens
+    auto& header = *reinterpret_cast<syntax::token::TokenStreamHeader*>(stream.data());
+    header.floating_format = header.floating_format % 4 + 1;
+    check(not syntax::token::TokenStreamView::open(stream), "stream of another float format opens", tokens.size());
+}
+
+std::size_t lexInput(std::string_view text) {
+    core::source::SourceManager sources;
+    core::types::DiagnosticsEngine diags(nullptr);
+    core::types::StringInterner interner;
+    auto file = sources.addBuffer("fuzz.c", core::source::SourceBuffer::fromString(text));
+    fend::lexer::Lexer lexer(sources, diags, interner, file.value());
+    lexer.setErrorRecovery(true);
+    auto batch = lexer.tokenizeAll();
+
+    const auto& tokens = batch.tokens;
+    auto size = sources.buffer(file.value()).size();
+    std::size_t end = 0;
+    for (std::size_t i = 0; i < tokens.size(); i++) {
+        auto token = tokens[i];
+        check(token.offset >= end, "overlaps the token before it", i);
+        check(token.length > 0, "is empty", i);
+        check(token.offset + token.length <= size, "ends past the text", i);
+        end = token.offset + token.length;
+    }
+    check(not batch.error, "lexing stopped at an error despite recovery", tokens.size());
+    checkStream(tokens);
+    return diags.errorCount();
+}
+
+}  // namespace cless::fuzz
@@ -0,0 +1,16 @@
+#ifndef CLESS_FUZZ_HARNESS_H
+#define CLESS_FUZZ_HARNESS_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace cless::fuzz {
+
+// Lexes text as one translation unit with error recovery and no error limit, the way the driver does, and aborts if
+// the token buffer breaks an invariant: tokens in order, not overlapping, not empty and inside the text, and read back
+// the same from a binary token stream. Returns the number of errors reported.
+std::size_t lexInput(std::string_view text);
+
+}  // namespace cless::fuzz
+
+#endif
@@ -0,0 +1,10 @@
+#include <cstddef>
+#include <cstdint>
+
+#include "harness.h"
+
+// entry point for libFuzzer, and for fuzz_main.cpp where libFuzzer is not available
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    cless::fuzz::lexInput({reinterpret_cast<const char*>(data), size});
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "pathological.h"
+
+namespace cless::fuzz {
+
+namespace {
+
+std::string repeat(
+    std::string_view unit,
+    std::size_t size,
+    std::string_view prefix = "",
+    std::string_view suffix = "") {
+    std::string text(prefix);
+    while (text.size() + suffix.size() < size)
+        text += unit;
+    text += suffix;
+    return text;
+}
+
+}  // namespace
+
+const std::vector<Pathological> &pathologicalInputs() {
+    static const std::vector<Pathological> inputs = {
+        // phase 2
+        {"splice-run", [](std::size_t size) { return repeat("\\\n", size, "int x", "y;\n"); }},
+        {"splice-in-identifier", [](std::size_t size) { return repeat("a\\\n", size, "", ";\n"); }},
+        {"splice-in-punctuation", [](std::size_t size) { return repeat("<\\\n<\\\n=\\\n", size); }},
+        {"splice-in-literal", [](std::size_t size) { return repeat("ab\\\n", size, "\"", "\";\n"); }},
+        {"splice-in-line-comment", [](std::size_t size) { return repeat("comment \\\n", size, "// ", "\nx;\n"); }},
+        // comments
+        {"unterminated-block-comment", [](std::size_t size) { return repeat("* / *\n", size, "/*"); }, 1},
+        {"nested-comment-openers", [](std::size_t size) { return repeat("/* ", size, "", "*/\n"); }, 0},
+        {"comment-per-line", [](std::size_t size) { return repeat("/**/ //\n", size); }, 0},
+        {"embedded-nul-in-comment",
+         [](std::size_t size) { return repeat(std::string_view("/* \0 */ x\n", 10), size); },
+         0},
+        {"embedded-nul", [](std::size_t size) { return repeat(std::string_view("\0\0\0 x\n", 6), size); }},
+        // literals
+        {"unterminated-string", [](std::size_t size) { return repeat("\\\\\\t", size, "\""); }},
+        {"unterminated-strings", [](std::size_t size) { return repeat("\"abc\n", size); }},
+        {"escape-run", [](std::size_t size) { return repeat("\\x41\\101\\n", size, "\"", "\";\n"); }},
+        {"bad-hex-escapes", [](std::size_t size) { return repeat("\\x\\xg", size, "\"", "\";\n"); }},
+        {"empty-characters", [](std::size_t size) { return repeat("''", size); }},
+        // numbers and identifiers
+        {"long-integer", [](std::size_t size) { return repeat("9", size, "", ";\n"); }},
+        {"long-floating", [](std::size_t size) { return repeat("1", size, "0.", "e5;\n"); }},
+        {"long-pp-number", [](std::size_t size) { return repeat("e+.", size, "1"); }},
+        {"long-suffix", [](std::size_t size) { return repeat("u", size, "1"); }},
+        {"long-identifier", [](std::size_t size) { return repeat("identifier", size, "", ";\n"); }},
+        // stray characters and punctuators
+        {"stray-characters", [](std::size_t size) { return repeat("@`$", size); }},
+        {"dots", [](std::size_t size) { return repeat(".", size); }},
+        {"operators", [](std::size_t size) { return repeat("<<=>>=->++", size); }},
+    };
+    return inputs;
+}
+
+}  // namespace cless::fuzz
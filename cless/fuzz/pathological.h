@@ -0,0 +1,25 @@
+#ifndef CLESS_FUZZ_PATHOLOGICAL_H
+#define CLESS_FUZZ_PATHOLOGICAL_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cless::fuzz {
+
+// Input shapes that have made a scanner do more than a constant amount of work per byte: one long construct, or the
+// same short construct many times. Each makes about size bytes.
+struct Pathological {
+    std::string_view name;
+    std::string (*make)(std::size_t size);
+    // the errors a lexer reports for it at any size, if that does not depend on the size
+    std::optional<std::size_t> errors = std::nullopt;
+};
+
+const std::vector<Pathological> &pathologicalInputs();
+
+}  // namespace cless::fuzz
+
+#endif
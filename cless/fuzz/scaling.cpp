@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harness.h"
+#include "pathological.h"
+
+namespace {
+
+// a linear scanner takes factor times as long on an input factor times as large; anything past allowed_growth times
+// that is taken for super-linear, which at this factor already shows as 8x for quadratic work
+constexpr std::size_t factor = 8;
+constexpr double allowed_growth = 3.0;
+constexpr int repetitions = 3;
+
+// the fastest of a few runs, and the errors reported by the last one
+double seconds(const std::string& text, std::size_t& errors) {
+    double best = 0;
+    for (int i = 0; i < repetitions; i++) {
+        auto start = std::chrono::steady_clock::now();
+        errors = cless::fuzz::lexInput(text);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+}  // namespace
+
+// Lexes every pathological input at a base size and at factor times that size and fails when time grows faster than
+// the input, or when an input with a known number of errors gets a different number. Takes --size=BYTES for the base
+// size and the names of the inputs to run, all of them by default.
+int main(int argc, char* argv[]) {
+    std::size_t size = 256 * 1024;
+    std::vector<std::string_view> names;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--size="))
+            size = std::stoull(std::string(arg.substr(std::string_view("--size=").size())));
+        else
+            names.push_back(arg);
+    }
+
+    bool failed = false;
+    std::printf("%-28s %12s %12s %8s\n", "input", "small (ms)", "large (ms)", "growth");
+    for (const auto& input : cless::fuzz::pathologicalInputs()) {
+        if (not names.empty() and std::find(names.begin(), names.end(), input.name) == names.end())
+            continue;
+        std::size_t small_errors = 0;
+        std::size_t large_errors = 0;
+        // the minimum keeps timer resolution out of the ratio for inputs that lex almost for free
+        auto small = std::max(seconds(input.make(size), small_errors), 1e-3);
+        auto large = seconds(input.make(size * factor), large_errors);
+        auto growth = large / small / factor;
+        bool linear = growth <= allowed_growth;
+        bool counted =
+            not input.errors.has_value() or (small_errors == *input.errors and large_errors == *input.errors);
+        std::printf(
+            "%-28.*s %12.3f %12.3f %8.2f%s\n",
+            static_cast<int>(input.name.size()),
+            input.name.data(),
+            small * 1e3,
+            large * 1e3,
+            growth,
+            linear ? "" : "  super-linear");
+        if (not counted)
+            std::printf("%28s %zu and %zu errors, expected %zu\n", "", small_errors, large_errors, *input.errors);
+        failed = failed or not linear or not counted;
+    }
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,24 +1,259 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
+#include "cless/core/instrument/instrument.h"
+#include "cless/core/parallel/thread_pool.h"
 #include "cless/core/print/ansi_escape.h"
+#include "cless/core/print/buffered_writer.h"
 #include "cless/front-end/lexer/lexer.h"
+#include "cless/front-end/lexer/stream_lexer.h"
+#include "cless/syntax/token/token_stream.h"
 
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << cless::core::print::Bold << "cless: " << cless::core::print::Red
-                  << "error:" << cless::core::print::Reset << " no input file" << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-
-    cless::fend::lexer::Lexer lexer(argv[1]);
-    while (true) {
-        auto token = lexer.next();
-        for (const auto& msg : token.msg)
-            std::cerr << msg << std::endl;
-        if (token.error)
-            return EXIT_FAILURE;
-        if (not token.tok.has_value())
+namespace {
+namespace print = cless::core::print;
+
+enum class Dump {
+    Text,
+    Binary,
+};
+
+struct Options {
+    std::vector<std::string> paths;
+    // tokens are printed as text unless --dump-tokens=binary asks for a token stream
+    Dump dump = Dump::Text;
+    // 0 runs one job per hardware thread
+    std::size_t jobs = 0;
+    bool warnings_as_errors = false;
+    std::size_t error_limit = 0;
+    bool time_report = false;
+    // empty for no trace
+    std::string trace;
+};
+
+[[noreturn]] void fatal(std::string_view message) {
+    std::cerr << print::Bold << "cless: " << print::Red << "error:" << print::Reset << " " << message << std::endl;
+    std::exit(EXIT_FAILURE);
+}
+
+std::size_t parseCount(std::string_view arg, std::string_view text) {
+    std::size_t count = 0;
+    if (text.empty())
+        fatal("missing number in '" + std::string(arg) + "'");
+    for (char c : text) {
+        if (c < '0' or c > '9')
+            fatal("invalid number in '" + std::string(arg) + "'");
+        std::size_t digit = c - '0';
+        if (count > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+            fatal("number too large in '" + std::string(arg) + "'");
+        count = count * 10 + digit;
+    }
+    return count;
+}
+
+// far more jobs than hardware threads only add threads that wait for a core, and a mistyped count could start millions
+std::size_t maxJobs() {
+    return std::max(64u, 4 * std::thread::hardware_concurrency());
+}
+
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "-Werror") {
+            options.warnings_as_errors = true;
+        } else if (arg.starts_with("-ferror-limit=")) {
+            options.error_limit = parseCount(arg, arg.substr(std::string_view("-ferror-limit=").size()));
+        } else if (arg == "-ftime-report") {
+            options.time_report = true;
+        } else if (arg.starts_with("--trace=")) {
+            options.trace = arg.substr(std::string_view("--trace=").size());
+            if (options.trace.empty())
+                fatal("missing file name in '" + std::string(arg) + "'");
+        } else if (arg == "--dump-tokens" or arg == "--dump-tokens=text") {
+            options.dump = Dump::Text;
+        } else if (arg == "--dump-tokens=binary") {
+            options.dump = Dump::Binary;
+        } else if (arg == "-j") {
+            if (i + 1 == argc)
+                fatal("missing number after '-j'");
+            options.jobs = parseCount(arg, argv[++i]);
+        } else if (arg.starts_with("-j")) {
+            options.jobs = parseCount(arg, arg.substr(2));
+        } else if (arg.starts_with("-") and arg != "-") {
+            fatal("unknown argument '" + std::string(arg) + "'");
+        } else {
+            options.paths.emplace_back(arg);
+        }
+    }
+    if (options.paths.empty())
+        fatal("no input file");
+    if (options.jobs > maxJobs())
+        fatal("job count " + std::to_string(options.jobs) + " exceeds the limit of " + std::to_string(maxJobs()));
+    return options;
+}
+
+// appends the tokens in the requested dump format to out; false, with the error on err, if they do not fit the format
+bool dump(
+    const Options& options,
+    const cless::syntax::token::TokenBuffer& tokens,
+    const std::string& path,
+    std::string& out,
+    std::ostream& err) {
+    cless::core::instrument::Timer timer("dump tokens", path);
+    switch (options.dump) {
+        case Dump::Text:
+            cless::syntax::token::dumpTokens(tokens, out);
+            break;
+        case Dump::Binary:
+            if (not cless::syntax::token::writeTokenStream(tokens, path, out)) {
+                err << print::Bold << "cless: " << print::Red << "error:" << print::Reset << " tokens of " << path
+                    << " exceed the 4 GiB limit of a token stream" << std::endl;
+                return false;
+            }
             break;
-        std::cout << token.tok.value() << std::endl;
     }
+    return true;
+}
+
+// everything one translation unit prints, held back until every unit before it is printed
+struct Output {
+    std::string out;
+    std::string err;
+    bool failed = false;
+};
+
+// Work that is shared by the translation units of a batch. Sources are cached by path and identifiers are interned
+// once, so a header used by many units is read and hashed once.
+struct Batch {
+    const Options& options;
+    cless::core::source::SourceManager sources;
+    cless::core::types::StringInterner interner;
+    cless::core::parallel::ThreadPool pool;
+
+    explicit Batch(const Options& options) : options(options), pool(options.jobs) {}
+};
+
+Output compile(Batch& batch, const std::string& path) {
+    cless::core::instrument::Timer timer("compile", path);
+    Output output;
+    std::ostringstream err;
+    auto file = batch.sources.loadFile(path);
+    if (not file.has_value()) {
+        err << print::Bold << "cless: " << print::Red << "error:" << print::Reset << " cannot open " << path << ": "
+            << std::strerror(file.error()) << std::endl;
+        output.err = std::move(err).str();
+        output.failed = true;
+        return output;
+    }
+
+    cless::core::types::DiagnosticsEngine diags([&](const cless::core::types::Message& msg) {
+        cless::core::types::printMessage(err, msg, batch.sources) << '\n';
+    });
+    diags.setWarningsAsErrors(batch.options.warnings_as_errors);
+    diags.setErrorLimit(batch.options.error_limit);
+
+    cless::fend::lexer::Lexer lexer(batch.sources, diags, batch.interner, file.value());
+    lexer.setErrorRecovery(true);
+    auto tokens = lexer.tokenizeAll(batch.pool);
+    bool dumped = dump(batch.options, tokens.tokens, path, output.out, err);
+    if (diags.limitReached())
+        err << print::Bold << "cless: " << print::Red << "error:" << print::Reset
+            << " too many errors emitted, stopping now" << '\n';
+
+    output.err = std::move(err).str();
+    output.failed = tokens.error or diags.hasErrors() or not dumped;
+    return output;
+}
+
+// Lexes stdin window by window and dumps as it goes, so a generator can be piped in without the compiler holding
+// all of its output. A binary dump has one stream per window. Only used when stdin is the sole input; in a batch it is
+// read whole like any other unit, because its output waits for the units before it.
+bool stream(Batch& batch, cless::core::print::BufferedWriter& out) {
+    cless::core::types::DiagnosticsEngine diags([&](const cless::core::types::Message& msg) {
+        cless::core::types::printMessage(std::cerr, msg, batch.sources) << '\n';
+    });
+    diags.setWarningsAsErrors(batch.options.warnings_as_errors);
+    diags.setErrorLimit(batch.options.error_limit);
+
+    cless::fend::lexer::StreamLexer lexer(batch.sources, diags, batch.interner, STDIN_FILENO, "-");
+    lexer.setErrorRecovery(true);
+    bool error = false;
+    std::string text;
+    while (auto tokens = lexer.next()) {
+        text.clear();
+        bool dumped = dump(batch.options, tokens->tokens, lexer.path(), text, std::cerr);
+        out.write(text);
+        error = error or tokens->error or not dumped;
+    }
+    out.flush();
+    if (diags.limitReached())
+        std::cerr << print::Bold << "cless: " << print::Red << "error:" << print::Reset
+                  << " too many errors emitted, stopping now" << std::endl;
+    return not error and not diags.hasErrors();
+}
+
+// the time report and the trace, once everything is compiled and printed
+bool report(const Options& options) {
+    if (options.time_report)
+        cless::core::instrument::writeTimeReport(std::cerr);
+    if (not options.trace.empty() and not cless::core::instrument::writeTrace(options.trace)) {
+        std::cerr << print::Bold << "cless: " << print::Red << "error:" << print::Reset << " cannot write "
+                  << options.trace << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto options = parseOptions(argc, argv);
+    if (options.time_report or not options.trace.empty()) {
+        // before the pool starts, so that its workers get their tracks
+        cless::core::instrument::enable();
+        cless::core::instrument::setThreadName("main");
+    }
+    Batch batch(options);
+    cless::core::print::BufferedWriter out(STDOUT_FILENO);
+    if (options.paths.size() == 1 and options.paths.front() == "-") {
+        bool ok = stream(batch, out) and not out.failed();
+        return report(options) and ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // units run in any order, but a unit is printed only once every unit before it is, so the output does not
+    // depend on the number of jobs
+    std::vector<Output> outputs(options.paths.size());
+    std::vector<bool> done(options.paths.size(), false);
+    std::size_t printed = 0;
+    bool failed = false;
+    std::mutex mutex;
+    batch.pool.parallelFor(options.paths.size(), [&](std::size_t i) {
+        auto output = compile(batch, options.paths[i]);
+        std::lock_guard lock(mutex);
+        outputs[i] = std::move(output);
+        done[i] = true;
+        for (; printed < outputs.size() and done[printed]; printed++) {
+            out.write(outputs[printed].out);
+            // stdout is only flushed where it has to stay in order with messages on stderr
+            if (not outputs[printed].err.empty()) {
+                out.flush();
+                std::cerr << outputs[printed].err << std::flush;
+            }
+            failed = failed or outputs[printed].failed;
+            outputs[printed] = {};
+        }
+    });
+    out.flush();
+    if (not report(options) or failed or out.failed())
+        return EXIT_FAILURE;
 }
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <iostream>
 #include <optional>
+#include <string_view>
 
 #include "cless/syntax/token/tokenbase.h"
 
@@ -23,18 +24,31 @@ enum class IntegerSuffix {
     UnsignedLongLong,
 };
 std::ostream &operator<<(std::ostream &os, IntegerSuffix suffix);
-std::optional<IntegerSuffix> integerSuffixFromStr(const std::string &str);
+std::optional<IntegerSuffix> integerSuffixFromStr(std::string_view str);
+
+// the type an integer constant gets from its value, base and suffix
+enum class IntegerType {
+    Int,
+    UnsignedInt,
+    Long,
+    UnsignedLong,
+    LongLong,
+    UnsignedLongLong,
+};
+std::ostream &operator<<(std::ostream &os, IntegerType type);
 
 struct IntegerConstant : public Constant<IntegerConstant> {
-    std::intmax_t value;
+    std::uintmax_t value;
     IntegerSuffix suffix;
-    std::string source;
+    IntegerType type;
+    std::string_view source;
 
     IntegerConstant(
-        std::intmax_t value,
+        std::uintmax_t value,
         IntegerSuffix suffix,
-        std::string source,
-        std::string file,
+        IntegerType type,
+        std::string_view source,
+        core::source::SourceLocation location,
         std::size_t line_start,
         std::size_t line_end,
         std::size_t col_start,
@@ -49,18 +63,18 @@ enum class FloatingSuffix {
     LongDouble,
 };
 std::ostream &operator<<(std::ostream &os, FloatingSuffix suffix);
-std::optional<FloatingSuffix> floatingSuffixFromStr(const std::string &str);
+std::optional<FloatingSuffix> floatingSuffixFromStr(std::string_view str);
 
 struct FloatingConstant : public Constant<FloatingConstant> {
     long double value;
     FloatingSuffix suffix;
-    std::string source;
+    std::string_view source;
 
     FloatingConstant(
         long double value,
         FloatingSuffix suffix,
-        std::string source,
-        std::string file,
+        std::string_view source,
+        core::source::SourceLocation location,
         std::size_t line_start,
         std::size_t line_end,
         std::size_t col_start,
@@ -71,12 +85,12 @@ std::ostream &operator<<(std::ostream &os, const FloatingConstant &constant);
 
 struct CharacterConstant : public Constant<CharacterConstant> {
     std::intmax_t value;
-    std::string source;
+    std::string_view source;
 
     CharacterConstant(
         std::intmax_t value,
-        std::string source,
-        std::string file,
+        std::string_view source,
+        core::source::SourceLocation location,
         std::size_t line_start,
         std::size_t line_end,
         std::size_t col_start,
@@ -0,0 +1,28 @@
+#ifndef CLESS_CORE_SYNTAX_ERROR_TOKEN_H
+#define CLESS_CORE_SYNTAX_ERROR_TOKEN_H
+
+#include <iostream>
+#include <string_view>
+
+#include "cless/syntax/token/tokenbase.h"
+
+namespace cless::syntax::token {
+
+// the text of a malformed token that was reported and skipped, so lexing could go on
+struct ErrorToken : public TokenBase {
+    std::string_view source;
+
+    ErrorToken(
+        std::string_view source,
+        core::source::SourceLocation location,
+        std::size_t line_start,
+        std::size_t line_end,
+        std::size_t col_start,
+        std::size_t col_end);
+};
+
+std::ostream &operator<<(std::ostream &os, const ErrorToken &error);
+
+}  // namespace cless::syntax::token
+
+#endif
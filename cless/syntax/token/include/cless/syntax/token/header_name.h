@@ -14,7 +14,7 @@ struct HeaderName : public TokenBase {
     HeaderName(
         std::string name,
         bool is_system,
-        std::string file,
+        core::source::SourceLocation location,
         std::size_t line_start,
         std::size_t line_end,
         std::size_t col_start,
@@ -2,17 +2,21 @@
 #define CLESS_CORE_SYNTAX_IDENTIFIER_H
 
 #include <iostream>
+#include <string_view>
 
+#include "cless/core/types/string_interner.h"
 #include "cless/syntax/token/tokenbase.h"
 
 namespace cless::syntax::token {
 
 struct Identifier : public TokenBase {
-    std::string name;
+    std::string_view name;
+    core::types::Symbol symbol;
 
     Identifier(
-        std::string name,
-        std::string file,
+        std::string_view name,
+        core::types::Symbol symbol,
+        core::source::SourceLocation location,
         std::size_t line_start,
         std::size_t line_end,
         std::size_t col_start,
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <optional>
+#include <string_view>
 
 #include "cless/syntax/token/tokenbase.h"
 
@@ -43,7 +44,7 @@ enum class KeywordType {
     If,
 };
 std::ostream &operator<<(std::ostream &os, KeywordType type);
-std::optional<KeywordType> keywordTypeFromStr(const std::string &str);
+std::optional<KeywordType> keywordTypeFromStr(std::string_view str);
 
 template <typename Derived>
 struct Keyword : public TokenBase {
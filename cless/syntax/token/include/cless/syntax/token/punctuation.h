@@ -1,8 +1,11 @@
 #ifndef CLESS_CORE_SYNTAX_PUNCTUATION_H
 #define CLESS_CORE_SYNTAX_PUNCTUATION_H
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <optional>
+#include <string_view>
 
 #include "cless/syntax/token/tokenbase.h"
 
@@ -59,7 +62,115 @@ enum class PunctuationType {
     Hash,                    // #
 };
 std::ostream &operator<<(std::ostream &os, PunctuationType type);
-std::optional<PunctuationType> punctuationTypeFromStr(const std::string &str);
+std::optional<PunctuationType> punctuationTypeFromStr(std::string_view str);
+
+// spellings indexed by PunctuationType
+constexpr std::array<std::string_view, 48> punctuation_spellings{
+    "<<=",
+    ">>=",
+    "...",
+    "->",
+    "++",
+    "--",
+    "<<",
+    ">>",
+    "<=",
+    ">=",
+    "==",
+    "!=",
+    "&&",
+    "||",
+    "*=",
+    "/=",
+    "%=",
+    "+=",
+    "-=",
+    "&=",
+    "^=",
+    "|=",
+    "##",
+    "[",
+    "]",
+    "(",
+    ")",
+    "{",
+    "}",
+    ".",
+    "&",
+    "*",
+    "+",
+    "-",
+    "~",
+    "!",
+    "/",
+    "%",
+    "<",
+    ">",
+    "^",
+    "|",
+    "?",
+    ":",
+    ";",
+    "=",
+    ",",
+    "#",
+};
+
+struct PunctuationMatch {
+    PunctuationType type;
+    std::size_t length;
+};
+
+// punctuators longer than one byte grouped by their first byte, longest first; the remaining one or two bytes are
+// packed little-endian so that each candidate costs a single integer compare
+struct PunctuationCandidates {
+    std::array<std::uint16_t, 3> rest;
+    std::array<std::uint8_t, 3> length;
+    std::array<PunctuationType, 3> type;
+    std::uint8_t count;
+    std::optional<PunctuationType> single;
+};
+
+constexpr std::array<PunctuationCandidates, 256> punctuation_candidates = [] {
+    std::array<PunctuationCandidates, 256> candidates{};
+    for (std::size_t length = 3; length >= 1; length--) {
+        for (std::size_t i = 0; i < punctuation_spellings.size(); i++) {
+            auto spelling = punctuation_spellings[i];
+            if (spelling.size() != length)
+                continue;
+            auto &entry = candidates[static_cast<unsigned char>(spelling[0])];
+            auto type = static_cast<PunctuationType>(i);
+            if (length == 1) {
+                entry.single = type;
+                continue;
+            }
+            if (entry.count == entry.rest.size())
+                throw "too many punctuators share a first byte";
+            std::uint16_t rest = static_cast<unsigned char>(spelling[1]);
+            if (length == 3)
+                rest |= static_cast<std::uint16_t>(static_cast<unsigned char>(spelling[2]) << 8);
+            entry.rest[entry.count] = rest;
+            entry.length[entry.count] = static_cast<std::uint8_t>(length);
+            entry.type[entry.count] = type;
+            entry.count++;
+        }
+    }
+    return candidates;
+}();
+
+// longest punctuator at p (maximal munch); reads up to two bytes past p, which must be readable
+constexpr std::optional<PunctuationMatch> matchPunctuation(const char *p) {
+    const auto &entry = punctuation_candidates[static_cast<unsigned char>(p[0])];
+    std::uint16_t next = static_cast<unsigned char>(p[1]);
+    std::uint16_t next_two = next | static_cast<std::uint16_t>(static_cast<unsigned char>(p[2]) << 8);
+    for (std::uint8_t i = 0; i < entry.count; i++) {
+        if ((entry.length[i] == 3 ? next_two : next) == entry.rest[i])
+            return PunctuationMatch{entry.type[i], entry.length[i]};
+    }
+    if (entry.single.has_value())
+        return PunctuationMatch{entry.single.value(), 1};
+    return std::nullopt;
+}
 
 template <typename Derived>
 struct Punctuation : public TokenBase {
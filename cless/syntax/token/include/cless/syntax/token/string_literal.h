@@ -2,19 +2,20 @@
 #define CLESS_CORE_SYNTAX_STRING_LITERAL_H
 
 #include <iostream>
+#include <string_view>
 
 #include "cless/syntax/token/tokenbase.h"
 
 namespace cless::syntax::token {
 
 struct StringLiteral : public TokenBase {
-    std::string value;
-    std::string source;
+    std::string_view value;
+    std::string_view source;
 
     StringLiteral(
-        std::string value,
-        std::string source,
-        std::string file,
+        std::string_view value,
+        std::string_view source,
+        core::source::SourceLocation location,
         std::size_t line_start,
         std::size_t line_end,
         std::size_t col_start,
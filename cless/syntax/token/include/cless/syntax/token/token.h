@@ -4,6 +4,7 @@
 #include <variant>
 
 #include "cless/syntax/token/constant.h"
+#include "cless/syntax/token/error_token.h"
 #include "cless/syntax/token/header_name.h"
 #include "cless/syntax/token/identifier.h"
 #include "cless/syntax/token/keyword.h"
@@ -102,7 +103,9 @@ struct Token : public std::variant<
                    FloatingConstant,
                    CharacterConstant,
                    // string literal
-                   StringLiteral> {
+                   StringLiteral,
+                   // malformed token kept by error recovery
+                   ErrorToken> {
     using variant::variant;
 };
 
@@ -167,11 +170,20 @@ struct PreprocessingToken : public std::variant<
                                 FloatingConstant,
                                 CharacterConstant,
                                 // string literal
-                                StringLiteral> {
+                                StringLiteral,
+                                // malformed token kept by error recovery
+                                ErrorToken> {
     using variant::variant;
 };
 
 std::ostream &operator<<(std::ostream &os, const PreprocessingToken &pp_token);
+PreprocessingToken buildPunctuation(
+    PunctuationType type,
+    core::source::SourceLocation location,
+    std::size_t line_start,
+    std::size_t line_end,
+    std::size_t col_start,
+    std::size_t col_end);
 Token toToken(const PreprocessingToken &pp_token);
 
 }  // namespace cless::syntax::token
@@ -0,0 +1,146 @@
+#ifndef CLESS_SYNTAX_TOKEN_TOKEN_BUFFER_H
+#define CLESS_SYNTAX_TOKEN_TOKEN_BUFFER_H
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "cless/core/source/source_manager.h"
+#include "cless/core/types/arena.h"
+#include "cless/syntax/token/token.h"
+
+namespace cless::syntax::token {
+
+// Token kinds in the order of the Token alternatives, so a kind is also the variant index. Keywords occupy the first
+// 32 kinds in KeywordType order and punctuators the next 48 in PunctuationType order.
+enum class TokenKind : std::uint8_t {
+    Identifier = 80,
+    IntegerConstant,
+    FloatingConstant,
+    CharacterConstant,
+    StringLiteral,
+    Error,
+};
+
+constexpr std::size_t keyword_kind_count = 32;
+constexpr std::size_t punctuation_kind_count = 48;
+
+constexpr TokenKind toTokenKind(KeywordType type) {
+    return static_cast<TokenKind>(type);
+}
+
+constexpr TokenKind toTokenKind(PunctuationType type) {
+    return static_cast<TokenKind>(keyword_kind_count + static_cast<std::size_t>(type));
+}
+
+constexpr bool isKeyword(TokenKind kind) {
+    return static_cast<std::size_t>(kind) < keyword_kind_count;
+}
+
+constexpr bool isPunctuation(TokenKind kind) {
+    auto index = static_cast<std::size_t>(kind);
+    return index >= keyword_kind_count and index < keyword_kind_count + punctuation_kind_count;
+}
+
+// builds the Token of a keyword or punctuator kind
+Token buildToken(
+    TokenKind kind,
+    core::source::SourceLocation location,
+    std::size_t line_start,
+    std::size_t line_end,
+    std::size_t col_start,
+    std::size_t col_end);
+
+// 16-byte plain token: where its spelling is in the physical source, and the symbol of an identifier or an index
+// into the side table of its kind for constants and string literals
+struct CompactToken {
+    TokenKind kind;
+    std::uint32_t offset;
+    std::uint32_t length;
+    std::uint32_t payload;
+};
+static_assert(sizeof(CompactToken) == 16);
+
+struct IntegerValue {
+    std::uintmax_t value;
+    IntegerSuffix suffix;
+    IntegerType type;
+};
+
+struct FloatingValue {
+    long double value;
+    FloatingSuffix suffix;
+};
+
+// Structure-of-arrays token storage for one source file. Decoded values live in side tables; the spelling is read
+// back from the source text of the SourceManager, which must outlive the buffer. Lines and columns come from the
+// manager's line index of the file, so they cost no second scan of the text. Text that differs from the source, such as escaped string
+// contents or spellings with line splices removed, is copied into an arena owned by the buffer. The Token variant is
+// available as a view for code that still wants it; its text refers to the source or to the arena.
+class TokenBuffer {
+    const core::source::SourceManager *sources;
+    core::source::FileID file;
+    core::source::SourceLocation start;
+    std::string_view source;
+    std::size_t first_line;
+    std::vector<TokenKind> kinds;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> lengths;
+    std::vector<std::uint32_t> payloads;
+
+    std::vector<IntegerValue> integers;
+    std::vector<FloatingValue> floatings;
+    std::vector<std::intmax_t> characters;
+    std::vector<std::string_view> strings;
+    // indices of tokens whose spelling contains a line splice, with the spliced text
+    std::vector<std::pair<std::uint32_t, std::string_view>> unspliced;
+    core::types::Arena arena;
+
+public:
+    // tokens of file, which is registered with sources
+    TokenBuffer(const core::source::SourceManager &sources, core::source::FileID file);
+
+    std::size_t size() const;
+    bool empty() const;
+    void reserve(std::size_t n);
+    void clear();
+
+    void push(TokenKind kind, std::uint32_t offset, std::uint32_t length);
+    void pushIdentifier(std::uint32_t offset, std::uint32_t length, core::types::Symbol symbol);
+    void pushInteger(std::uint32_t offset, std::uint32_t length, IntegerValue value);
+    void pushFloating(std::uint32_t offset, std::uint32_t length, FloatingValue value);
+    void pushCharacter(std::uint32_t offset, std::uint32_t length, std::intmax_t value);
+    // value is copied into the arena unless it already lies in the source
+    void pushString(std::uint32_t offset, std::uint32_t length, std::string_view value);
+    // the spelling of the last pushed token without its line splices
+    void setUnspliced(std::string_view text);
+
+    // drops every token from index n on
+    void truncate(std::size_t n);
+    // moves the tokens of other, which must come from later in the same source, to the end of this buffer
+    void append(TokenBuffer &&other);
+
+    CompactToken operator[](std::size_t index) const;
+    TokenKind kind(std::size_t index) const;
+    std::string_view spelling(std::size_t index) const;
+    // spelling after line splicing
+    std::string_view text(std::size_t index) const;
+
+    core::types::Symbol symbol(std::size_t index) const;
+    const IntegerValue &integer(std::size_t index) const;
+    const FloatingValue &floating(std::size_t index) const;
+    std::intmax_t character(std::size_t index) const;
+    std::string_view string(std::size_t index) const;
+
+    Token token(std::size_t index) const;
+    // 1-based line and column where token index starts
+    std::pair<std::size_t, std::size_t> position(std::size_t index) const;
+
+private:
+    std::pair<std::size_t, std::size_t> lineAndColumn(std::uint32_t offset) const;
+};
+
+}  // namespace cless::syntax::token
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef CLESS_SYNTAX_TOKEN_TOKEN_STREAM_H
+#define CLESS_SYNTAX_TOKEN_TOKEN_STREAM_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "cless/syntax/token/token_buffer.h"
+
+namespace cless::syntax::token {
+
+// Binary token stream of one translation unit. It is self-contained, so a tool can map the file and read tokens
+// without the source and without lexing again. The layout is little-endian, the header comes first and every section
+// starts at a multiple of 8 bytes from it. A file may hold several streams back to back; total_size leads from one to
+// the next. Any change to the layout or to the TokenKind numbering bumps the version.
+//
+// Per token, in parallel arrays: kind (a TokenKind), physical offset and length in the source, 1-based line and column,
+// text (a span of bytes, the spelling with line splices removed) and payload. The payload indexes the integer,
+// floating, character or string table for constants and string literals and is 0 otherwise. Equal identifier
+// spellings share one text span, so the span offset identifies an identifier within the stream. Floating constants
+// keep the long double the lexer computed. Its format differs between hosts, so the header records it and a stream is
+// only opened on a host with the same format. A section holds at most 4 GiB, or 2^32 entries.
+struct TokenStreamHeader {
+    static constexpr char magic_bytes[4] = {'C', 'T', 'O', 'K'};
+    static constexpr std::uint16_t current_version = 3;
+
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t header_size;
+    std::uint32_t token_count;
+    std::uint32_t integer_count;
+    std::uint32_t floating_count;
+    std::uint32_t character_count;
+    std::uint32_t string_count;
+    std::uint32_t bytes_size;
+    std::uint64_t total_size;
+    // section offsets from the start of the header
+    std::uint64_t kinds;
+    std::uint64_t offsets;
+    std::uint64_t lengths;
+    std::uint64_t lines;
+    std::uint64_t columns;
+    std::uint64_t texts;
+    std::uint64_t payloads;
+    std::uint64_t integers;
+    std::uint64_t floatings;
+    std::uint64_t characters;
+    std::uint64_t strings;
+    std::uint64_t bytes;
+    // the source file path, in bytes
+    std::uint32_t path_offset;
+    std::uint32_t path_length;
+    // a StreamFloatingFormat
+    std::uint16_t floating_format;
+    std::uint8_t reserved[6];
+};
+static_assert(sizeof(TokenStreamHeader) == 152);
+
+// part of the bytes section
+struct StreamSpan {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct StreamInteger {
+    std::uint64_t value;
+    std::uint8_t suffix;
+    std::uint8_t type;
+    std::uint8_t reserved[6];
+};
+static_assert(sizeof(StreamInteger) == 16);
+
+// the long double format of the host that wrote a stream
+enum class StreamFloatingFormat : std::uint16_t {
+    // long double is double
+    Binary64 = 1,
+    // 64-bit significand in 10 bytes
+    X87Extended = 2,
+    Binary128 = 3,
+    // a pair of doubles
+    DoubleDouble = 4,
+};
+
+// the bytes of a long double that carry its value, followed by zeros; the x87 format pads 10 bytes to 16
+struct StreamFloating {
+    std::uint8_t value[16];
+    std::uint8_t suffix;
+    std::uint8_t reserved[7];
+};
+static_assert(sizeof(StreamFloating) == 24);
+
+// Appends the stream of tokens, lexed from the file at path, to out. false, leaving out as it was, if a section would
+// not fit the 32-bit counts and offsets of the format.
+bool writeTokenStream(const TokenBuffer &tokens, std::string_view path, std::string &out);
+
+// Reads a stream in place, typically from a mapped file. open() checks the header and that every section lies inside
+// data; the accessors then only index.
+class TokenStreamView {
+    const char *base;
+    const TokenStreamHeader *header;
+
+public:
+    // nullopt if data does not start with a valid stream of the current version
+    static std::optional<TokenStreamView> open(std::string_view data);
+
+    // bytes of this stream; the next stream of the same file, if any, starts there
+    std::uint64_t totalSize() const;
+    std::string_view path() const;
+
+    std::size_t size() const;
+    TokenKind kind(std::size_t index) const;
+    std::uint32_t offset(std::size_t index) const;
+    std::uint32_t length(std::size_t index) const;
+    std::uint32_t line(std::size_t index) const;
+    std::uint32_t column(std::size_t index) const;
+    std::string_view text(std::size_t index) const;
+    // text span offset of an identifier, equal for equal spellings
+    std::uint32_t identifier(std::size_t index) const;
+
+    const StreamInteger &integer(std::size_t index) const;
+    FloatingValue floating(std::size_t index) const;
+    std::int64_t character(std::size_t index) const;
+    // value of a string literal with escapes decoded
+    std::string_view string(std::size_t index) const;
+
+private:
+    TokenStreamView(const char *base);
+
+    template <typename T>
+    const T *section(std::uint64_t offset) const;
+    std::string_view span(const StreamSpan &span) const;
+};
+
+// appends one line per token to out, the same text operator<< prints for the Token, without going through a stream
+void dumpTokens(const TokenBuffer &tokens, std::string &out);
+// the same text for the tokens of a stream
+void dumpTokens(const TokenStreamView &tokens, std::string &out);
+
+}  // namespace cless::syntax::token
+
+#endif
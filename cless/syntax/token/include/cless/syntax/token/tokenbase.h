@@ -3,15 +3,22 @@
 
 #include <string>
 
+#include "cless/core/source/source_location.h"
+
 namespace cless::syntax::token {
 
 struct TokenBase {
-    std::string file;
+    // where the token's spelling starts
+    core::source::SourceLocation location;
     std::size_t line_start, line_end;
     std::size_t col_start, col_end;
 
     TokenBase(
-        std::string file, std::size_t line_start, std::size_t line_end, std::size_t col_start, std::size_t col_end);
+        core::source::SourceLocation location,
+        std::size_t line_start,
+        std::size_t line_end,
+        std::size_t col_start,
+        std::size_t col_end);
 };
 
 }  // namespace cless::syntax::token
@@ -22,38 +22,73 @@ std::ostream& operator<<(std::ostream& os, IntegerSuffix suffix) {
     throw core::types::Exception("Unknown integer suffix");
 }
 
-std::optional<IntegerSuffix> integerSuffixFromStr(const std::string& str) {
-    if (str == "")
-        return IntegerSuffix::None;
-    else if (str == "u" or str == "U")
-        return IntegerSuffix::Unsigned;
-    else if (str == "l" or str == "L")
-        return IntegerSuffix::Long;
-    else if (str == "ul" or str == "lu" or str == "UL" or str == "LU")
-        return IntegerSuffix::UnsignedLong;
-    else if (str == "ll" or str == "LL")
-        return IntegerSuffix::LongLong;
-    else if (
-        str == "ull" or str == "llu" or str == "uLL" or str == "LLu" or str == "Ull" or str == "llU" or str == "ULL" or
-        str == "LLU")
-        return IntegerSuffix::UnsignedLongLong;
-    else
+std::optional<IntegerSuffix> integerSuffixFromStr(std::string_view str) {
+    // an optional u or U and an optional l, L, ll or LL, in either order
+    std::size_t i = 0;
+    bool is_unsigned = false;
+    std::size_t longs = 0;
+    auto takeUnsigned = [&] {
+        if (i < str.size() and (str[i] == 'u' or str[i] == 'U')) {
+            is_unsigned = true;
+            i++;
+        }
+    };
+    auto takeLong = [&] {
+        if (i < str.size() and (str[i] == 'l' or str[i] == 'L')) {
+            longs = i + 1 < str.size() and str[i + 1] == str[i] ? 2 : 1;
+            i += longs;
+        }
+    };
+    takeUnsigned();
+    takeLong();
+    if (not is_unsigned)
+        takeUnsigned();
+    if (i != str.size())
         return std::nullopt;
+
+    switch (longs) {
+        case 0:
+            return is_unsigned ? IntegerSuffix::Unsigned : IntegerSuffix::None;
+        case 1:
+            return is_unsigned ? IntegerSuffix::UnsignedLong : IntegerSuffix::Long;
+        default:
+            return is_unsigned ? IntegerSuffix::UnsignedLongLong : IntegerSuffix::LongLong;
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, IntegerType type) {
+    switch (type) {
+        case IntegerType::Int:
+            return os << "int", os;
+        case IntegerType::UnsignedInt:
+            return os << "unsigned int", os;
+        case IntegerType::Long:
+            return os << "long", os;
+        case IntegerType::UnsignedLong:
+            return os << "unsigned long", os;
+        case IntegerType::LongLong:
+            return os << "long long", os;
+        case IntegerType::UnsignedLongLong:
+            return os << "unsigned long long", os;
+    }
+    throw core::types::Exception("Unknown integer type");
 }
 
 IntegerConstant::IntegerConstant(
-    std::intmax_t value,
+    std::uintmax_t value,
     IntegerSuffix suffix,
-    std::string source,
-    std::string file,
+    IntegerType type,
+    std::string_view source,
+    core::source::SourceLocation location,
     std::size_t line_start,
     std::size_t line_end,
     std::size_t col_start,
     std::size_t col_end)
-    : Constant(std::move(file), line_start, line_end, col_start, col_end),
+    : Constant(location, line_start, line_end, col_start, col_end),
       value(value),
       suffix(suffix),
-      source(std::move(source)) {}
+      type(type),
+      source(source) {}
 
 std::ostream& operator<<(std::ostream& os, const IntegerConstant& constant) {
     return os << "IntegerConstant " << constant.source, os;
@@ -71,7 +106,7 @@ std::ostream& operator<<(std::ostream& os, FloatingSuffix suffix) {
     throw core::types::Exception("Unknown floating suffix");
 }
 
-std::optional<FloatingSuffix> floatingSuffixFromStr(const std::string& str) {
+std::optional<FloatingSuffix> floatingSuffixFromStr(std::string_view str) {
     if (str == "")
         return FloatingSuffix::None;
     else if (str == "f" or str == "F")
@@ -85,16 +120,13 @@ std::optional<FloatingSuffix> floatingSuffixFromStr(const std::string& str) {
 FloatingConstant::FloatingConstant(
     long double value,
     FloatingSuffix suffix,
-    std::string source,
-    std::string file,
+    std::string_view source,
+    core::source::SourceLocation location,
     std::size_t line_start,
     std::size_t line_end,
     std::size_t col_start,
     std::size_t col_end)
-    : Constant(std::move(file), line_start, line_end, col_start, col_end),
-      value(value),
-      suffix(suffix),
-      source(std::move(source)) {}
+    : Constant(location, line_start, line_end, col_start, col_end), value(value), suffix(suffix), source(source) {}
 
 std::ostream& operator<<(std::ostream& os, const FloatingConstant& constant) {
     return os << "FloatingConstant " << constant.source, os;
@@ -102,13 +134,13 @@ std::ostream& operator<<(std::ostream& os, const FloatingConstant& constant) {
 
 CharacterConstant::CharacterConstant(
     std::intmax_t value,
-    std::string source,
-    std::string file,
+    std::string_view source,
+    core::source::SourceLocation location,
     std::size_t line_start,
     std::size_t line_end,
     std::size_t col_start,
     std::size_t col_end)
-    : Constant(std::move(file), line_start, line_end, col_start, col_end), value(value), source(std::move(source)) {}
+    : Constant(location, line_start, line_end, col_start, col_end), value(value), source(source) {}
 
 std::ostream& operator<<(std::ostream& os, const CharacterConstant& constant) {
     return os << "CharacterConstant '" << constant.source << "'", os;
@@ -0,0 +1,18 @@
+#include "cless/syntax/token/error_token.h"
+
+namespace cless::syntax::token {
+
+ErrorToken::ErrorToken(
+    std::string_view source,
+    core::source::SourceLocation location,
+    std::size_t line_start,
+    std::size_t line_end,
+    std::size_t col_start,
+    std::size_t col_end)
+    : TokenBase(location, line_start, line_end, col_start, col_end), source(source) {}
+
+std::ostream &operator<<(std::ostream &os, const ErrorToken &error) {
+    return os << "ErrorToken " << error.source;
+}
+
+}  // namespace cless::syntax::token
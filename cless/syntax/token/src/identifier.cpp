@@ -3,13 +3,14 @@
 namespace cless::syntax::token {
 
 Identifier::Identifier(
-    std::string name,
-    std::string file,
+    std::string_view name,
+    core::types::Symbol symbol,
+    core::source::SourceLocation location,
     std::size_t line_start,
     std::size_t line_end,
     std::size_t col_start,
     std::size_t col_end)
-    : TokenBase(std::move(file), line_start, line_end, col_start, col_end), name(std::move(name)) {}
+    : TokenBase(location, line_start, line_end, col_start, col_end), name(name), symbol(symbol) {}
 
 std::ostream &operator<<(std::ostream &os, const Identifier &identifier) {
     return os << "Identifier " << identifier.name;
@@ -1,5 +1,7 @@
 #include "cless/syntax/token/keyword.h"
 
+#include <array>
+
 #include "cless/core/types/exception.h"
 
 namespace cless::syntax::token {
@@ -74,72 +76,93 @@ std::ostream &operator<<(std::ostream &os, KeywordType type) {
     throw core::types::Exception("Unknown keyword type");
 }
 
-std::optional<KeywordType> keywordTypeFromStr(const std::string &str) {
-    if (str == "continue")
-        return KeywordType::Continue;
-    if (str == "register")
-        return KeywordType::Register;
-    if (str == "unsigned")
-        return KeywordType::Unsigned;
-    if (str == "volatile")
-        return KeywordType::Volatile;
-    if (str == "default")
-        return KeywordType::Default;
-    if (str == "typedef")
-        return KeywordType::Typedef;
-    if (str == "double")
-        return KeywordType::Double;
-    if (str == "extern")
-        return KeywordType::Extern;
-    if (str == "return")
-        return KeywordType::Return;
-    if (str == "signed")
-        return KeywordType::Signed;
-    if (str == "sizeof")
-        return KeywordType::Sizeof;
-    if (str == "static")
-        return KeywordType::Static;
-    if (str == "struct")
-        return KeywordType::Struct;
-    if (str == "switch")
-        return KeywordType::Switch;
-    if (str == "break")
-        return KeywordType::Break;
-    if (str == "const")
-        return KeywordType::Const;
-    if (str == "float")
-        return KeywordType::Float;
-    if (str == "short")
-        return KeywordType::Short;
-    if (str == "while")
-        return KeywordType::While;
-    if (str == "union")
-        return KeywordType::Union;
-    if (str == "auto")
-        return KeywordType::Auto;
-    if (str == "case")
-        return KeywordType::Case;
-    if (str == "char")
-        return KeywordType::Char;
-    if (str == "else")
-        return KeywordType::Else;
-    if (str == "enum")
-        return KeywordType::Enum;
-    if (str == "goto")
-        return KeywordType::Goto;
-    if (str == "long")
-        return KeywordType::Long;
-    if (str == "void")
-        return KeywordType::Void;
-    if (str == "for")
-        return KeywordType::For;
-    if (str == "int")
-        return KeywordType::Int;
-    if (str == "do")
-        return KeywordType::Do;
-    if (str == "if")
-        return KeywordType::If;
-    return std::nullopt;
+struct KeywordEntry {
+    std::string_view spelling;
+    KeywordType type;
+};
+
+static constexpr std::array<KeywordEntry, 32> keywords{{
+    {"continue", KeywordType::Continue},
+    {"register", KeywordType::Register},
+    {"unsigned", KeywordType::Unsigned},
+    {"volatile", KeywordType::Volatile},
+    {"default", KeywordType::Default},
+    {"typedef", KeywordType::Typedef},
+    {"double", KeywordType::Double},
+    {"extern", KeywordType::Extern},
+    {"return", KeywordType::Return},
+    {"signed", KeywordType::Signed},
+    {"sizeof", KeywordType::Sizeof},
+    {"static", KeywordType::Static},
+    {"struct", KeywordType::Struct},
+    {"switch", KeywordType::Switch},
+    {"break", KeywordType::Break},
+    {"const", KeywordType::Const},
+    {"float", KeywordType::Float},
+    {"short", KeywordType::Short},
+    {"while", KeywordType::While},
+    {"union", KeywordType::Union},
+    {"auto", KeywordType::Auto},
+    {"case", KeywordType::Case},
+    {"char", KeywordType::Char},
+    {"else", KeywordType::Else},
+    {"enum", KeywordType::Enum},
+    {"goto", KeywordType::Goto},
+    {"long", KeywordType::Long},
+    {"void", KeywordType::Void},
+    {"for", KeywordType::For},
+    {"int", KeywordType::Int},
+    {"do", KeywordType::Do},
+    {"if", KeywordType::If},
+}};
+
+// keyword hash of the form (a * s[0] + b * s[1] + s[n - 1] + c * n) mod 64; every C89 keyword has at least two
+// characters
+struct KeywordHash {
+    std::size_t a, b, c;
+
+    constexpr std::size_t operator()(std::string_view str) const {
+        auto byte = [&str](std::size_t i) { return static_cast<std::size_t>(static_cast<unsigned char>(str[i])); };
+        return (a * byte(0) + b * byte(1) + byte(str.size() - 1) + c * str.size()) % 64;
+    }
+};
+
+static constexpr bool isPerfect(KeywordHash hash) {
+    std::array<bool, 64> used{};
+    for (const auto &keyword : keywords) {
+        auto slot = hash(keyword.spelling);
+        if (used[slot])
+            return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+// search the smallest multipliers that map every keyword to its own slot
+static constexpr KeywordHash keyword_hash = [] {
+    for (std::size_t a = 1; a < 64; a++)
+        for (std::size_t b = 0; b < 64; b++)
+            for (std::size_t c = 0; c < 8; c++)
+                if (isPerfect({a, b, c}))
+                    return KeywordHash{a, b, c};
+    return KeywordHash{0, 0, 0};
+}();
+static_assert(isPerfect(keyword_hash), "no perfect hash for the keyword set");
+
+static constexpr std::array<KeywordEntry, 64> keyword_table = [] {
+    std::array<KeywordEntry, 64> table{};
+    for (const auto &keyword : keywords)
+        table[keyword_hash(keyword.spelling)] = keyword;
+    return table;
+}();
+
+std::optional<KeywordType> keywordTypeFromStr(std::string_view str) {
+    if (str.size() < 2 or str.size() > 8)
+        return std::nullopt;
+    const auto &entry = keyword_table[keyword_hash(str)];
+    if (entry.spelling != str)
+        return std::nullopt;
+    return entry.type;
 }
 
 }  // namespace cless::syntax::token
@@ -3,16 +3,14 @@
 namespace cless::syntax::token {
 
 StringLiteral::StringLiteral(
-    std::string value,
-    std::string source,
-    std::string file,
+    std::string_view value,
+    std::string_view source,
+    core::source::SourceLocation location,
     std::size_t line_start,
     std::size_t line_end,
     std::size_t col_start,
     std::size_t col_end)
-    : TokenBase(std::move(file), line_start, line_end, col_start, col_end),
-      value(std::move(value)),
-      source(std::move(source)) {}
+    : TokenBase(location, line_start, line_end, col_start, col_end), value(value), source(source) {}
 
 std::ostream &operator<<(std::ostream &os, const StringLiteral &literal) {
     return os << "StringLiteral \"" << literal.source << "\"", os;
@@ -1,6 +1,10 @@
 #include "cless/syntax/token/token.h"
 
+#include <array>
+#include <utility>
+
 #include "cless/core/types/exception.h"
+#include "cless/syntax/token/token_buffer.h"
 
 namespace cless::syntax::token {
 
@@ -14,80 +18,37 @@ std::ostream &operator<<(std::ostream &os, const PreprocessingToken &pp_token) {
     return os;
 }
 
-static Token buildKeyword(
-    KeywordType type,
-    std::string file,
+// PreprocessingToken holds HeaderName first and then one alternative per PunctuationType, in enum order
+template <std::size_t... I>
+static constexpr auto makePunctuationBuilders(std::index_sequence<I...>) {
+    static_assert(((std::variant_alternative_t<I + 1, PreprocessingToken::variant>::type ==
+                    static_cast<PunctuationType>(I)) and
+                   ...));
+    using Builder =
+        PreprocessingToken (*)(core::source::SourceLocation, std::size_t, std::size_t, std::size_t, std::size_t);
+    return std::array<Builder, sizeof...(I)>{
+        [](core::source::SourceLocation location,
+           std::size_t line_start,
+           std::size_t line_end,
+           std::size_t col_start,
+           std::size_t col_end) -> PreprocessingToken {
+            return PreprocessingToken(std::in_place_index<I + 1>, location, line_start, line_end, col_start, col_end);
+        }...};
+}
+
+static constexpr auto punctuation_builders =
+    makePunctuationBuilders(std::make_index_sequence<punctuation_spellings.size()>{});
+
+PreprocessingToken buildPunctuation(
+    PunctuationType type,
+    core::source::SourceLocation location,
     std::size_t line_start,
     std::size_t line_end,
     std::size_t col_start,
     std::size_t col_end) {
-    switch (type) {
-        case KeywordType::Continue:
-            return Continue(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Register:
-            return Register(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Unsigned:
-            return Unsigned(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Volatile:
-            return Volatile(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Default:
-            return Default(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Typedef:
-            return Typedef(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Double:
-            return Double(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Extern:
-            return Extern(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Return:
-            return Return(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Signed:
-            return Signed(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Sizeof:
-            return Sizeof(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Static:
-            return Static(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Struct:
-            return Struct(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Switch:
-            return Switch(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Break:
-            return Break(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Const:
-            return Const(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Float:
-            return Float(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Short:
-            return Short(file, line_start, line_end, col_start, col_end);
-        case KeywordType::While:
-            return While(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Union:
-            return Union(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Auto:
-            return Auto(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Case:
-            return Case(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Char:
-            return Char(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Else:
-            return Else(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Enum:
-            return Enum(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Goto:
-            return Goto(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Long:
-            return Long(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Void:
-            return Void(file, line_start, line_end, col_start, col_end);
-        case KeywordType::For:
-            return For(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Int:
-            return Int(file, line_start, line_end, col_start, col_end);
-        case KeywordType::Do:
-            return Do(file, line_start, line_end, col_start, col_end);
-        case KeywordType::If:
-            return If(file, line_start, line_end, col_start, col_end);
-    }
-    throw core::types::Exception("Unknown keyword type");
+    if (auto index = static_cast<std::size_t>(type); index < punctuation_builders.size())
+        return punctuation_builders[index](location, line_start, line_end, col_start, col_end);
+    throw core::types::Exception("Unknown punctuation type");
 }
 
 struct PpTokenToTokenVisitor {
@@ -100,8 +61,13 @@ struct PpTokenToTokenVisitor {
 
     Token operator()(const Identifier &ident) const {
         if (auto type = keywordTypeFromStr(ident.name); type.has_value())
-            return buildKeyword(
-                type.value(), ident.file, ident.line_start, ident.line_end, ident.col_start, ident.col_end);
+            return buildToken(
+                toTokenKind(type.value()),
+                ident.location,
+                ident.line_start,
+                ident.line_end,
+                ident.col_start,
+                ident.col_end);
         return ident;
     }
 
@@ -111,6 +77,8 @@ struct PpTokenToTokenVisitor {
     }
 
     Token operator()(const StringLiteral &str_lit) const { return str_lit; }
+
+    Token operator()(const ErrorToken &error) const { return error; }
 };
 
 Token toToken(const PreprocessingToken &pp_token) {
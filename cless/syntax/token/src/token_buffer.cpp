@@ -0,0 +1,287 @@
+#include "cless/syntax/token/token_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <utility>
+
+#include "cless/core/types/exception.h"
+
+namespace cless::syntax::token {
+
+template <std::size_t... I>
+static constexpr bool hasKindOrder(std::index_sequence<I...>) {
+    auto matches = []<std::size_t K>(std::integral_constant<std::size_t, K>) {
+        using Alternative = std::variant_alternative_t<K, Token::variant>;
+        if constexpr (K < keyword_kind_count)
+            return Alternative::type == static_cast<KeywordType>(K);
+        else
+            return Alternative::type == static_cast<PunctuationType>(K - keyword_kind_count);
+    };
+    return (matches(std::integral_constant<std::size_t, I>{}) and ...);
+}
+
+static_assert(hasKindOrder(std::make_index_sequence<keyword_kind_count + punctuation_kind_count>{}));
+static_assert(std::is_same_v<
+              std::variant_alternative_t<static_cast<std::size_t>(TokenKind::Identifier), Token::variant>,
+              Identifier>);
+static_assert(std::is_same_v<
+              std::variant_alternative_t<static_cast<std::size_t>(TokenKind::StringLiteral), Token::variant>,
+              StringLiteral>);
+static_assert(std::is_same_v<
+              std::variant_alternative_t<static_cast<std::size_t>(TokenKind::Error), Token::variant>,
+              ErrorToken>);
+
+template <std::size_t... I>
+static constexpr auto makeTokenBuilders(std::index_sequence<I...>) {
+    using Builder = Token (*)(core::source::SourceLocation, std::size_t, std::size_t, std::size_t, std::size_t);
+    return std::array<Builder, sizeof...(I)>{
+        [](core::source::SourceLocation location,
+           std::size_t line_start,
+           std::size_t line_end,
+           std::size_t col_start,
+           std::size_t col_end) -> Token {
+            return Token(std::in_place_index<I>, location, line_start, line_end, col_start, col_end);
+        }...};
+}
+
+// keywords and punctuators carry nothing but their position
+static constexpr auto token_builders =
+    makeTokenBuilders(std::make_index_sequence<keyword_kind_count + punctuation_kind_count>{});
+
+static std::string_view unquote(std::string_view text) {
+    return text.substr(1, text.size() - 2);
+}
+
+Token buildToken(
+    TokenKind kind,
+    core::source::SourceLocation location,
+    std::size_t line_start,
+    std::size_t line_end,
+    std::size_t col_start,
+    std::size_t col_end) {
+    if (static_cast<std::size_t>(kind) >= token_builders.size())
+        throw core::types::Exception("Token kind carries a value");
+    return token_builders[static_cast<std::size_t>(kind)](location, line_start, line_end, col_start, col_end);
+}
+
+TokenBuffer::TokenBuffer(const core::source::SourceManager& sources, core::source::FileID file)
+    : sources(&sources),
+      file(file),
+      start(sources.startOf(file)),
+      source(sources.buffer(file).view()),
+      first_line(sources.firstLine(file)) {}
+
+std::size_t TokenBuffer::size() const {
+    return kinds.size();
+}
+
+bool TokenBuffer::empty() const {
+    return kinds.empty();
+}
+
+void TokenBuffer::reserve(std::size_t n) {
+    kinds.reserve(n);
+    offsets.reserve(n);
+    lengths.reserve(n);
+    payloads.reserve(n);
+}
+
+void TokenBuffer::clear() {
+    kinds.clear();
+    offsets.clear();
+    lengths.clear();
+    payloads.clear();
+    integers.clear();
+    floatings.clear();
+    characters.clear();
+    strings.clear();
+    unspliced.clear();
+    arena = core::types::Arena();
+}
+
+void TokenBuffer::push(TokenKind kind, std::uint32_t offset, std::uint32_t length) {
+    kinds.push_back(kind);
+    offsets.push_back(offset);
+    lengths.push_back(length);
+    payloads.push_back(0);
+}
+
+void TokenBuffer::pushIdentifier(std::uint32_t offset, std::uint32_t length, core::types::Symbol symbol) {
+    push(TokenKind::Identifier, offset, length);
+    payloads.back() = symbol.value();
+}
+
+void TokenBuffer::pushInteger(std::uint32_t offset, std::uint32_t length, IntegerValue value) {
+    push(TokenKind::IntegerConstant, offset, length);
+    payloads.back() = static_cast<std::uint32_t>(integers.size());
+    integers.push_back(value);
+}
+
+void TokenBuffer::pushFloating(std::uint32_t offset, std::uint32_t length, FloatingValue value) {
+    push(TokenKind::FloatingConstant, offset, length);
+    payloads.back() = static_cast<std::uint32_t>(floatings.size());
+    floatings.push_back(value);
+}
+
+void TokenBuffer::pushCharacter(std::uint32_t offset, std::uint32_t length, std::intmax_t value) {
+    push(TokenKind::CharacterConstant, offset, length);
+    payloads.back() = static_cast<std::uint32_t>(characters.size());
+    characters.push_back(value);
+}
+
+void TokenBuffer::pushString(std::uint32_t offset, std::uint32_t length, std::string_view value) {
+    push(TokenKind::StringLiteral, offset, length);
+    payloads.back() = static_cast<std::uint32_t>(strings.size());
+    std::less<const char*> before;
+    bool in_source = not before(value.data(), source.data()) and
+                     not before(source.data() + source.size(), value.data() + value.size());
+    strings.push_back(in_source ? value : arena.copy(value));
+}
+
+void TokenBuffer::setUnspliced(std::string_view text) {
+    unspliced.emplace_back(static_cast<std::uint32_t>(kinds.size() - 1), arena.copy(text));
+}
+
+void TokenBuffer::truncate(std::size_t n) {
+    if (n >= kinds.size())
+        return;
+    // side table entries are in token order, so the first dropped token of a kind marks the new end of its table
+    auto cut = [&](auto& table, TokenKind kind) {
+        auto it = std::find(kinds.begin() + n, kinds.end(), kind);
+        if (it != kinds.end())
+            table.resize(payloads[it - kinds.begin()]);
+    };
+    cut(integers, TokenKind::IntegerConstant);
+    cut(floatings, TokenKind::FloatingConstant);
+    cut(characters, TokenKind::CharacterConstant);
+    cut(strings, TokenKind::StringLiteral);
+    while (not unspliced.empty() and unspliced.back().first >= n)
+        unspliced.pop_back();
+    kinds.resize(n);
+    offsets.resize(n);
+    lengths.resize(n);
+    payloads.resize(n);
+}
+
+void TokenBuffer::append(TokenBuffer&& other) {
+    auto base = static_cast<std::uint32_t>(kinds.size());
+    kinds.insert(kinds.end(), other.kinds.begin(), other.kinds.end());
+    offsets.insert(offsets.end(), other.offsets.begin(), other.offsets.end());
+    lengths.insert(lengths.end(), other.lengths.begin(), other.lengths.end());
+
+    // payloads of constants and string literals index side tables, which are appended behind ours
+    payloads.reserve(payloads.size() + other.payloads.size());
+    for (std::size_t i = 0; i < other.kinds.size(); i++) {
+        std::uint32_t shift = 0;
+        switch (other.kinds[i]) {
+            case TokenKind::IntegerConstant:
+                shift = static_cast<std::uint32_t>(integers.size());
+                break;
+            case TokenKind::FloatingConstant:
+                shift = static_cast<std::uint32_t>(floatings.size());
+                break;
+            case TokenKind::CharacterConstant:
+                shift = static_cast<std::uint32_t>(characters.size());
+                break;
+            case TokenKind::StringLiteral:
+                shift = static_cast<std::uint32_t>(strings.size());
+                break;
+            default:
+                break;
+        }
+        payloads.push_back(other.payloads[i] + shift);
+    }
+    integers.insert(integers.end(), other.integers.begin(), other.integers.end());
+    floatings.insert(floatings.end(), other.floatings.begin(), other.floatings.end());
+    characters.insert(characters.end(), other.characters.begin(), other.characters.end());
+    strings.insert(strings.end(), other.strings.begin(), other.strings.end());
+    for (const auto& [index, text] : other.unspliced)
+        unspliced.emplace_back(base + index, text);
+    arena.merge(std::move(other.arena));
+    other.clear();
+}
+
+CompactToken TokenBuffer::operator[](std::size_t index) const {
+    return {kinds[index], offsets[index], lengths[index], payloads[index]};
+}
+
+TokenKind TokenBuffer::kind(std::size_t index) const {
+    return kinds[index];
+}
+
+std::string_view TokenBuffer::spelling(std::size_t index) const {
+    return source.substr(offsets[index], lengths[index]);
+}
+
+std::string_view TokenBuffer::text(std::size_t index) const {
+    // splices are rare, so most files never search
+    if (unspliced.empty())
+        return spelling(index);
+    auto it = std::lower_bound(
+        unspliced.begin(), unspliced.end(), index, [](const auto& entry, std::size_t i) { return entry.first < i; });
+    if (it != unspliced.end() and it->first == index)
+        return it->second;
+    return spelling(index);
+}
+
+core::types::Symbol TokenBuffer::symbol(std::size_t index) const {
+    return core::types::Symbol(payloads[index]);
+}
+
+const IntegerValue& TokenBuffer::integer(std::size_t index) const {
+    return integers[payloads[index]];
+}
+
+const FloatingValue& TokenBuffer::floating(std::size_t index) const {
+    return floatings[payloads[index]];
+}
+
+std::intmax_t TokenBuffer::character(std::size_t index) const {
+    return characters[payloads[index]];
+}
+
+std::string_view TokenBuffer::string(std::size_t index) const {
+    return strings[payloads[index]];
+}
+
+Token TokenBuffer::token(std::size_t index) const {
+    auto location = start.withOffset(offsets[index]);
+    auto [line_start, col_start] = lineAndColumn(offsets[index]);
+    auto [line_end, col_end] = lineAndColumn(offsets[index] + lengths[index]);
+    switch (auto kind = kinds[index]) {
+        case TokenKind::Identifier:
+            return Identifier(text(index), symbol(index), location, line_start, line_end, col_start, col_end);
+        case TokenKind::IntegerConstant: {
+            const auto& [value, suffix, type] = integer(index);
+            return IntegerConstant(
+                value, suffix, type, text(index), location, line_start, line_end, col_start, col_end);
+        }
+        case TokenKind::FloatingConstant: {
+            const auto& [value, suffix] = floating(index);
+            return FloatingConstant(value, suffix, text(index), location, line_start, line_end, col_start, col_end);
+        }
+        case TokenKind::CharacterConstant:
+            return CharacterConstant(
+                character(index), unquote(text(index)), location, line_start, line_end, col_start, col_end);
+        case TokenKind::StringLiteral:
+            return StringLiteral(
+                string(index), unquote(text(index)), location, line_start, line_end, col_start, col_end);
+        case TokenKind::Error:
+            return ErrorToken(text(index), location, line_start, line_end, col_start, col_end);
+        default:
+            return buildToken(kind, location, line_start, line_end, col_start, col_end);
+    }
+}
+
+std::pair<std::size_t, std::size_t> TokenBuffer::position(std::size_t index) const {
+    return lineAndColumn(offsets[index]);
+}
+
+std::pair<std::size_t, std::size_t> TokenBuffer::lineAndColumn(std::uint32_t offset) const {
+    const auto& lines = sources->lineIndex(file);
+    auto line = lines.lineOf(offset);
+    return {first_line + line - 1, lines.columnOf(offset, line)};
+}
+
+}  // namespace cless::syntax::token
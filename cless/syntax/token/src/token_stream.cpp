@@ -0,0 +1,341 @@
+#include "cless/syntax/token/token_stream.h"
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace cless::syntax::token {
+
+static_assert(std::endian::native == std::endian::little, "token streams are written in host byte order");
+
+static std::string_view category(TokenKind kind) {
+    if (isKeyword(kind))
+        return "Keyword";
+    if (isPunctuation(kind))
+        return "Punctuation";
+    switch (kind) {
+        case TokenKind::Identifier:
+            return "Identifier";
+        case TokenKind::IntegerConstant:
+            return "IntegerConstant";
+        case TokenKind::FloatingConstant:
+            return "FloatingConstant";
+        case TokenKind::CharacterConstant:
+            return "CharacterConstant";
+        case TokenKind::StringLiteral:
+            return "StringLiteral";
+        case TokenKind::Error:
+            return "ErrorToken";
+    }
+    return "";
+}
+
+template <typename Tokens>
+static void dump(const Tokens& tokens, std::string& out) {
+    // every token prints as its category and its text: quotes of literals are part of the text, and keywords and
+    // punctuators are spelled the way they print
+    for (std::size_t i = 0; i < tokens.size(); i++) {
+        out += category(tokens.kind(i));
+        out += ' ';
+        out += tokens.text(i);
+        out += '\n';
+    }
+}
+
+void dumpTokens(const TokenBuffer& tokens, std::string& out) {
+    dump(tokens, out);
+}
+
+void dumpTokens(const TokenStreamView& tokens, std::string& out) {
+    dump(tokens, out);
+}
+
+// x87 extended precision has 64 digits in 10 bytes; the rest of its storage is padding of unspecified value
+static constexpr std::size_t long_double_bytes =
+    std::numeric_limits<long double>::digits == 64 ? 10 : sizeof(long double);
+static_assert(long_double_bytes <= sizeof(StreamFloating::value));
+
+// told apart by their significand, which is all that differs between the formats hosts use for long double
+static constexpr StreamFloatingFormat host_floating_format = [] {
+    switch (std::numeric_limits<long double>::digits) {
+        case 53:
+            return StreamFloatingFormat::Binary64;
+        case 64:
+            return StreamFloatingFormat::X87Extended;
+        case 113:
+            return StreamFloatingFormat::Binary128;
+        case 106:
+            return StreamFloatingFormat::DoubleDouble;
+    }
+    throw "unknown long double format";
+}();
+
+static std::uint64_t align(std::uint64_t size) {
+    return (size + 7) & ~std::uint64_t(7);
+}
+
+bool writeTokenStream(const TokenBuffer& tokens, std::string_view path, std::string& out) {
+    auto count = tokens.size();
+    std::vector<TokenKind> kinds(count);
+    std::vector<std::uint32_t> offsets(count), lengths(count), lines(count), columns(count), payloads(count);
+    std::vector<StreamSpan> texts(count);
+    std::vector<StreamInteger> integers;
+    std::vector<StreamFloating> floatings;
+    std::vector<std::int64_t> characters;
+    std::vector<StreamSpan> strings;
+
+    std::string bytes;
+    auto store = [&bytes](std::string_view text) {
+        StreamSpan span{static_cast<std::uint32_t>(bytes.size()), static_cast<std::uint32_t>(text.size())};
+        bytes += text;
+        return span;
+    };
+    // identifiers, keywords and punctuators repeat a lot, so their spellings are stored once
+    std::unordered_map<std::string_view, StreamSpan> shared;
+    auto path_span = store(path);
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto token = tokens[i];
+        kinds[i] = token.kind;
+        offsets[i] = token.offset;
+        lengths[i] = token.length;
+        auto [line, column] = tokens.position(i);
+        lines[i] = static_cast<std::uint32_t>(line);
+        columns[i] = static_cast<std::uint32_t>(column);
+        auto text = tokens.text(i);
+        switch (token.kind) {
+            case TokenKind::IntegerConstant: {
+                const auto& value = tokens.integer(i);
+                payloads[i] = static_cast<std::uint32_t>(integers.size());
+                integers.push_back(
+                    {value.value, static_cast<std::uint8_t>(value.suffix), static_cast<std::uint8_t>(value.type), {}});
+                texts[i] = store(text);
+                break;
+            }
+            case TokenKind::FloatingConstant: {
+                const auto& value = tokens.floating(i);
+                payloads[i] = static_cast<std::uint32_t>(floatings.size());
+                StreamFloating floating{{}, static_cast<std::uint8_t>(value.suffix), {}};
+                std::memcpy(floating.value, &value.value, long_double_bytes);
+                floatings.push_back(floating);
+                texts[i] = store(text);
+                break;
+            }
+            case TokenKind::CharacterConstant:
+                payloads[i] = static_cast<std::uint32_t>(characters.size());
+                characters.push_back(tokens.character(i));
+                texts[i] = store(text);
+                break;
+            case TokenKind::StringLiteral:
+                payloads[i] = static_cast<std::uint32_t>(strings.size());
+                strings.push_back(store(tokens.string(i)));
+                texts[i] = store(text);
+                break;
+            case TokenKind::Error:
+                texts[i] = store(text);
+                break;
+            default: {
+                auto [it, inserted] = shared.try_emplace(text);
+                if (inserted)
+                    it->second = store(text);
+                texts[i] = it->second;
+                break;
+            }
+        }
+    }
+
+    // every span offset is below bytes_size, so checking the sizes covers the offsets as well
+    constexpr std::size_t limit = std::numeric_limits<std::uint32_t>::max();
+    if (count > limit or bytes.size() > limit)
+        return false;
+
+    TokenStreamHeader header{};
+    std::memcpy(header.magic, TokenStreamHeader::magic_bytes, sizeof(header.magic));
+    header.version = TokenStreamHeader::current_version;
+    header.header_size = sizeof(TokenStreamHeader);
+    header.token_count = static_cast<std::uint32_t>(count);
+    header.integer_count = static_cast<std::uint32_t>(integers.size());
+    header.floating_count = static_cast<std::uint32_t>(floatings.size());
+    header.character_count = static_cast<std::uint32_t>(characters.size());
+    header.string_count = static_cast<std::uint32_t>(strings.size());
+    header.bytes_size = static_cast<std::uint32_t>(bytes.size());
+    header.path_offset = path_span.offset;
+    header.path_length = path_span.length;
+    header.floating_format = static_cast<std::uint16_t>(host_floating_format);
+
+    std::uint64_t size = align(sizeof(TokenStreamHeader));
+    auto place = [&size](std::uint64_t& field, std::size_t section_size) {
+        field = size;
+        size = align(size + section_size);
+    };
+    place(header.kinds, count * sizeof(TokenKind));
+    place(header.offsets, count * sizeof(std::uint32_t));
+    place(header.lengths, count * sizeof(std::uint32_t));
+    place(header.lines, count * sizeof(std::uint32_t));
+    place(header.columns, count * sizeof(std::uint32_t));
+    place(header.texts, count * sizeof(StreamSpan));
+    place(header.payloads, count * sizeof(std::uint32_t));
+    place(header.integers, integers.size() * sizeof(StreamInteger));
+    place(header.floatings, floatings.size() * sizeof(StreamFloating));
+    place(header.characters, characters.size() * sizeof(std::int64_t));
+    place(header.strings, strings.size() * sizeof(StreamSpan));
+    place(header.bytes, bytes.size());
+    header.total_size = size;
+
+    // padding between sections stays zero, so equal token buffers give equal streams
+    auto start = out.size();
+    out.resize(start + size, '\0');
+    char* base = out.data() + start;
+    auto copy = [base](std::uint64_t offset, const auto& section) {
+        if (not section.empty())
+            std::memcpy(base + offset, section.data(), section.size() * sizeof(section[0]));
+    };
+    std::memcpy(base, &header, sizeof(header));
+    copy(header.kinds, kinds);
+    copy(header.offsets, offsets);
+    copy(header.lengths, lengths);
+    copy(header.lines, lines);
+    copy(header.columns, columns);
+    copy(header.texts, texts);
+    copy(header.payloads, payloads);
+    copy(header.integers, integers);
+    copy(header.floatings, floatings);
+    copy(header.characters, characters);
+    copy(header.strings, strings);
+    copy(header.bytes, bytes);
+    return true;
+}
+
+TokenStreamView::TokenStreamView(const char* base)
+    : base(base), header(reinterpret_cast<const TokenStreamHeader*>(base)) {}
+
+std::optional<TokenStreamView> TokenStreamView::open(std::string_view data) {
+    if (data.size() < sizeof(TokenStreamHeader) or reinterpret_cast<std::uintptr_t>(data.data()) % 8 != 0)
+        return std::nullopt;
+    TokenStreamView view(data.data());
+    const auto& h = *view.header;
+    if (std::memcmp(h.magic, TokenStreamHeader::magic_bytes, sizeof(h.magic)) != 0 or
+        h.version != TokenStreamHeader::current_version or h.header_size != sizeof(TokenStreamHeader) or
+        h.floating_format != static_cast<std::uint16_t>(host_floating_format) or h.total_size > data.size())
+        return std::nullopt;
+
+    auto fits = [&h](std::uint64_t offset, std::uint64_t count, std::uint64_t element_size) {
+        return offset % 8 == 0 and offset <= h.total_size and count <= (h.total_size - offset) / element_size;
+    };
+    std::uint64_t n = h.token_count;
+    if (not fits(h.kinds, n, sizeof(TokenKind)) or not fits(h.offsets, n, 4) or not fits(h.lengths, n, 4) or
+        not fits(h.lines, n, 4) or not fits(h.columns, n, 4) or not fits(h.texts, n, sizeof(StreamSpan)) or
+        not fits(h.payloads, n, 4) or not fits(h.integers, h.integer_count, sizeof(StreamInteger)) or
+        not fits(h.floatings, h.floating_count, sizeof(StreamFloating)) or
+        not fits(h.characters, h.character_count, sizeof(std::int64_t)) or
+        not fits(h.strings, h.string_count, sizeof(StreamSpan)) or not fits(h.bytes, h.bytes_size, 1))
+        return std::nullopt;
+
+    // spans and payloads are checked once here, so that reading a token never goes out of the stream
+    auto in_bytes = [&h](const StreamSpan& span) {
+        return span.offset <= h.bytes_size and span.length <= h.bytes_size - span.offset;
+    };
+    if (not in_bytes({h.path_offset, h.path_length}))
+        return std::nullopt;
+    for (std::size_t i = 0; i < h.string_count; i++)
+        if (not in_bytes(view.section<StreamSpan>(h.strings)[i]))
+            return std::nullopt;
+    for (std::size_t i = 0; i < n; i++) {
+        if (not in_bytes(view.section<StreamSpan>(h.texts)[i]))
+            return std::nullopt;
+        auto payload = view.section<std::uint32_t>(h.payloads)[i];
+        switch (view.kind(i)) {
+            case TokenKind::IntegerConstant:
+                if (payload >= h.integer_count)
+                    return std::nullopt;
+                break;
+            case TokenKind::FloatingConstant:
+                if (payload >= h.floating_count)
+                    return std::nullopt;
+                break;
+            case TokenKind::CharacterConstant:
+                if (payload >= h.character_count)
+                    return std::nullopt;
+                break;
+            case TokenKind::StringLiteral:
+                if (payload >= h.string_count)
+                    return std::nullopt;
+                break;
+            default:
+                break;
+        }
+    }
+    return view;
+}
+
+std::uint64_t TokenStreamView::totalSize() const {
+    return header->total_size;
+}
+
+std::string_view TokenStreamView::path() const {
+    return span({header->path_offset, header->path_length});
+}
+
+std::size_t TokenStreamView::size() const {
+    return header->token_count;
+}
+
+TokenKind TokenStreamView::kind(std::size_t index) const {
+    return section<TokenKind>(header->kinds)[index];
+}
+
+std::uint32_t TokenStreamView::offset(std::size_t index) const {
+    return section<std::uint32_t>(header->offsets)[index];
+}
+
+std::uint32_t TokenStreamView::length(std::size_t index) const {
+    return section<std::uint32_t>(header->lengths)[index];
+}
+
+std::uint32_t TokenStreamView::line(std::size_t index) const {
+    return section<std::uint32_t>(header->lines)[index];
+}
+
+std::uint32_t TokenStreamView::column(std::size_t index) const {
+    return section<std::uint32_t>(header->columns)[index];
+}
+
+std::string_view TokenStreamView::text(std::size_t index) const {
+    return span(section<StreamSpan>(header->texts)[index]);
+}
+
+std::uint32_t TokenStreamView::identifier(std::size_t index) const {
+    return section<StreamSpan>(header->texts)[index].offset;
+}
+
+const StreamInteger& TokenStreamView::integer(std::size_t index) const {
+    return section<StreamInteger>(header->integers)[section<std::uint32_t>(header->payloads)[index]];
+}
+
+FloatingValue TokenStreamView::floating(std::size_t index) const {
+    const auto& floating = section<StreamFloating>(header->floatings)[section<std::uint32_t>(header->payloads)[index]];
+    FloatingValue value{0.0L, static_cast<FloatingSuffix>(floating.suffix)};
+    std::memcpy(&value.value, floating.value, long_double_bytes);
+    return value;
+}
+
+std::int64_t TokenStreamView::character(std::size_t index) const {
+    return section<std::int64_t>(header->characters)[section<std::uint32_t>(header->payloads)[index]];
+}
+
+std::string_view TokenStreamView::string(std::size_t index) const {
+    return span(section<StreamSpan>(header->strings)[section<std::uint32_t>(header->payloads)[index]]);
+}
+
+template <typename T>
+const T* TokenStreamView::section(std::uint64_t offset) const {
+    return reinterpret_cast<const T*>(base + offset);
+}
+
+std::string_view TokenStreamView::span(const StreamSpan& span) const {
+    return {base + header->bytes + span.offset, span.length};
+}
+
+}  // namespace cless::syntax::token